@@ -166,6 +166,14 @@ OPENVKL_CATCH_END()
 // Interval iterator //////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+extern "C" size_t vklGetIntervalIteratorSize(VKLVolume volume)
+    OPENVKL_CATCH_BEGIN
+{
+  ASSERT_DRIVER();
+  return openvkl::api::currentDriver().getIntervalIteratorSize(volume);
+}
+OPENVKL_CATCH_END(0)
+
 extern "C" void vklInitIntervalIterator(VKLIntervalIterator *iterator,
                                         VKLVolume volume,
                                         const vkl_vec3f *origin,
@@ -260,6 +268,13 @@ __define_vklIterateIntervalN(16);
 // Hit iterator ///////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
+extern "C" size_t vklGetHitIteratorSize(VKLVolume volume) OPENVKL_CATCH_BEGIN
+{
+  ASSERT_DRIVER();
+  return openvkl::api::currentDriver().getHitIteratorSize(volume);
+}
+OPENVKL_CATCH_END(0)
+
 extern "C" void vklInitHitIterator(VKLHitIterator *iterator,
                                    VKLVolume volume,
                                    const vkl_vec3f *origin,
@@ -558,6 +573,37 @@ __define_vklComputeSampleN(16);
 
 #undef __define_vklComputeSampleN
 
+extern "C" void vklComputeSampleStream(VKLVolume volume,
+                                       size_t count,
+                                       const vkl_vec3f *objectCoordinates,
+                                       float *samples) OPENVKL_CATCH_BEGIN
+{
+  ASSERT_DRIVER();
+  openvkl::api::currentDriver().computeSampleStream(
+      volume,
+      count,
+      reinterpret_cast<const vec3f *>(objectCoordinates),
+      samples);
+}
+OPENVKL_CATCH_END()
+
+extern "C" void vklComputeSampleStreamSoA(VKLVolume volume,
+                                          size_t count,
+                                          const float *objectCoordinatesX,
+                                          const float *objectCoordinatesY,
+                                          const float *objectCoordinatesZ,
+                                          float *samples) OPENVKL_CATCH_BEGIN
+{
+  ASSERT_DRIVER();
+  openvkl::api::currentDriver().computeSampleStreamSoA(volume,
+                                                       count,
+                                                       objectCoordinatesX,
+                                                       objectCoordinatesY,
+                                                       objectCoordinatesZ,
+                                                       samples);
+}
+OPENVKL_CATCH_END()
+
 extern "C" vkl_vec3f vklComputeGradient(
     VKLVolume volume, const vkl_vec3f *objectCoordinates) OPENVKL_CATCH_BEGIN
 {
@@ -597,6 +643,105 @@ __define_vklComputeGradientN(16);
 
 #undef __define_vklComputeGradientN
 
+extern "C" float vklComputeSampleAndGradient(VKLVolume volume,
+                                             const vkl_vec3f *objectCoordinates,
+                                             vkl_vec3f *gradient)
+    OPENVKL_CATCH_BEGIN
+{
+  ASSERT_DRIVER();
+  constexpr int valid = 1;
+  float sample;
+  openvkl::api::currentDriver().computeSampleAndGradient1(
+      &valid,
+      volume,
+      reinterpret_cast<const vvec3fn<1> &>(*objectCoordinates),
+      reinterpret_cast<vfloatn<1> &>(sample),
+      reinterpret_cast<vvec3fn<1> &>(*gradient));
+  return sample;
+}
+OPENVKL_CATCH_END(ospcommon::math::nan)
+
+#define __define_vklComputeSampleAndGradientN(WIDTH)                  \
+  extern "C" void vklComputeSampleAndGradient##WIDTH(                 \
+      const int *valid,                                               \
+      VKLVolume volume,                                               \
+      const vkl_vvec3f##WIDTH *objectCoordinates,                     \
+      float *samples,                                                 \
+      vkl_vvec3f##WIDTH *gradients) OPENVKL_CATCH_BEGIN               \
+  {                                                                   \
+    ASSERT_DRIVER();                                                  \
+    ASSERT_DRIVER_SUPPORTS_WIDTH(WIDTH);                              \
+                                                                      \
+    openvkl::api::currentDriver().computeSampleAndGradient##WIDTH(    \
+        valid,                                                        \
+        volume,                                                       \
+        reinterpret_cast<const vvec3fn<WIDTH> &>(*objectCoordinates), \
+        reinterpret_cast<vfloatn<WIDTH> &>(*samples),                 \
+        reinterpret_cast<vvec3fn<WIDTH> &>(*gradients));              \
+  }                                                                   \
+  OPENVKL_CATCH_END()
+
+__define_vklComputeSampleAndGradientN(4);
+__define_vklComputeSampleAndGradientN(8);
+__define_vklComputeSampleAndGradientN(16);
+
+#undef __define_vklComputeSampleAndGradientN
+
+extern "C" void vklComputeSampleM(VKLVolume volume,
+                                  const vkl_vec3f *objectCoordinates,
+                                  float *samples,
+                                  unsigned int M,
+                                  const unsigned int *attributeIndices)
+    OPENVKL_CATCH_BEGIN
+{
+  ASSERT_DRIVER();
+  constexpr int valid = 1;
+  openvkl::api::currentDriver().computeSampleM1(
+      &valid,
+      volume,
+      reinterpret_cast<const vvec3fn<1> &>(*objectCoordinates),
+      samples,
+      M,
+      attributeIndices);
+}
+OPENVKL_CATCH_END()
+
+#define __define_vklComputeSampleMN(WIDTH)                            \
+  extern "C" void vklComputeSampleM##WIDTH(                           \
+      const int *valid,                                               \
+      VKLVolume volume,                                               \
+      const vkl_vvec3f##WIDTH *objectCoordinates,                     \
+      float *samples,                                                 \
+      unsigned int M,                                                 \
+      const unsigned int *attributeIndices) OPENVKL_CATCH_BEGIN       \
+  {                                                                   \
+    ASSERT_DRIVER();                                                  \
+    ASSERT_DRIVER_SUPPORTS_WIDTH(WIDTH);                              \
+                                                                      \
+    openvkl::api::currentDriver().computeSampleM##WIDTH(              \
+        valid,                                                        \
+        volume,                                                       \
+        reinterpret_cast<const vvec3fn<WIDTH> &>(*objectCoordinates), \
+        samples,                                                      \
+        M,                                                            \
+        attributeIndices);                                            \
+  }                                                                   \
+  OPENVKL_CATCH_END()
+
+__define_vklComputeSampleMN(4);
+__define_vklComputeSampleMN(8);
+__define_vklComputeSampleMN(16);
+
+#undef __define_vklComputeSampleMN
+
+extern "C" unsigned int vklGetNumAttributes(VKLVolume volume)
+    OPENVKL_CATCH_BEGIN
+{
+  ASSERT_DRIVER();
+  return openvkl::api::currentDriver().getNumAttributes(volume);
+}
+OPENVKL_CATCH_END(0)
+
 extern "C" vkl_box3f vklGetBoundingBox(VKLVolume volume) OPENVKL_CATCH_BEGIN
 {
   ASSERT_DRIVER();
@@ -604,3 +749,13 @@ extern "C" vkl_box3f vklGetBoundingBox(VKLVolume volume) OPENVKL_CATCH_BEGIN
   return reinterpret_cast<const vkl_box3f &>(result);
 }
 OPENVKL_CATCH_END(vkl_box3f{ospcommon::math::nan})
+
+extern "C" void vklVolumeUpdateRegion(VKLVolume volume,
+                                      const vkl_box3i *region)
+    OPENVKL_CATCH_BEGIN
+{
+  ASSERT_DRIVER();
+  openvkl::api::currentDriver().updateVolumeRegion(
+      volume, reinterpret_cast<const box3i &>(*region));
+}
+OPENVKL_CATCH_END()
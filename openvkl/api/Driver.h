@@ -80,6 +80,12 @@ namespace openvkl {
       // Interval iterator ////////////////////////////////////////////////////
       /////////////////////////////////////////////////////////////////////////
 
+      virtual size_t getIntervalIteratorSize(VKLVolume volume)
+      {
+        throw std::runtime_error(
+            "getIntervalIteratorSize() not implemented on this driver");
+      }
+
 #define __define_initIntervalIteratorN(WIDTH)                            \
   virtual void initIntervalIterator##WIDTH(                              \
       const int *valid,                                                  \
@@ -122,6 +128,12 @@ namespace openvkl {
       // Hit iterator /////////////////////////////////////////////////////////
       /////////////////////////////////////////////////////////////////////////
 
+      virtual size_t getHitIteratorSize(VKLVolume volume)
+      {
+        throw std::runtime_error(
+            "getHitIteratorSize() not implemented on this driver");
+      }
+
 #define __define_initHitIteratorN(WIDTH)                                 \
   virtual void initHitIterator##WIDTH(const int *valid,                  \
                                       vVKLHitIteratorN<WIDTH> &iterator, \
@@ -221,6 +233,26 @@ namespace openvkl {
 
 #undef __define_computeSampleN
 
+      virtual void computeSampleStream(VKLVolume volume,
+                                       size_t count,
+                                       const vec3f *objectCoordinates,
+                                       float *samples)
+      {
+        throw std::runtime_error(
+            "computeSampleStream() not implemented on this driver");
+      }
+
+      virtual void computeSampleStreamSoA(VKLVolume volume,
+                                          size_t count,
+                                          const float *objectCoordinatesX,
+                                          const float *objectCoordinatesY,
+                                          const float *objectCoordinatesZ,
+                                          float *samples)
+      {
+        throw std::runtime_error(
+            "computeSampleStreamSoA() not implemented on this driver");
+      }
+
 #define __define_computeGradientN(WIDTH)                                       \
   virtual void computeGradient##WIDTH(const int *valid,                        \
                                       VKLVolume volume,                        \
@@ -234,8 +266,59 @@ namespace openvkl {
 
 #undef __define_computeGradientN
 
+#define __define_computeSampleAndGradientN(WIDTH)                         \
+  virtual void computeSampleAndGradient##WIDTH(                           \
+      const int *valid,                                                   \
+      VKLVolume volume,                                                   \
+      const vvec3fn<WIDTH> &objectCoordinates,                            \
+      vfloatn<WIDTH> &samples,                                            \
+      vvec3fn<WIDTH> &gradients)                                          \
+  {                                                                       \
+    throw std::runtime_error(                                             \
+        "computeSampleAndGradient##WIDTH() not implemented on this driver"); \
+  }
+
+      __define_computeSampleAndGradientN(1);
+      __define_computeSampleAndGradientN(4);
+      __define_computeSampleAndGradientN(8);
+      __define_computeSampleAndGradientN(16);
+
+#undef __define_computeSampleAndGradientN
+
+#define __define_computeSampleMN(WIDTH)                            \
+  virtual void computeSampleM##WIDTH(                              \
+      const int *valid,                                            \
+      VKLVolume volume,                                            \
+      const vvec3fn<WIDTH> &objectCoordinates,                     \
+      float *samples,                                              \
+      unsigned int M,                                              \
+      const unsigned int *attributeIndices)                        \
+  {                                                                \
+    throw std::runtime_error(                                      \
+        "computeSampleM##WIDTH() not implemented on this driver"); \
+  }
+
+      __define_computeSampleMN(1);
+      __define_computeSampleMN(4);
+      __define_computeSampleMN(8);
+      __define_computeSampleMN(16);
+
+#undef __define_computeSampleMN
+
+      virtual unsigned int getNumAttributes(VKLVolume volume)
+      {
+        throw std::runtime_error(
+            "getNumAttributes() not implemented on this driver");
+      }
+
       virtual box3f getBoundingBox(VKLVolume volume) = 0;
 
+      virtual void updateVolumeRegion(VKLVolume volume, const box3i &region)
+      {
+        throw std::runtime_error(
+            "updateVolumeRegion() not implemented on this driver");
+      }
+
      private:
       bool committed = false;
     };
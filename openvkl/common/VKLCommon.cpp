@@ -111,6 +111,10 @@ namespace openvkl {
       return "ulong3";
     case VKL_ULONG4:
       return "ulong4";
+    case VKL_HALF:
+      return "half";
+    case VKL_BFLOAT16:
+      return "bfloat16";
     case VKL_FLOAT:
       return "float";
     case VKL_FLOAT2:
@@ -206,6 +210,9 @@ namespace openvkl {
       return sizeof(vec3ul);
     case VKL_ULONG4:
       return sizeof(vec4ul);
+    case VKL_HALF:
+    case VKL_BFLOAT16:
+      return sizeof(uint16);
     case VKL_FLOAT:
       return sizeof(float);
     case VKL_FLOAT2:
@@ -51,6 +51,14 @@ namespace openvkl {
                                     : ITERATOR_INTERNAL_STATE_SIZE_16));
   }
 
+  constexpr int iterator_internal_state_alignment_for_width(int W)
+  {
+    return W < 4 ? ITERATOR_INTERNAL_STATE_ALIGNMENT
+                 : (W < 8 ? ITERATOR_INTERNAL_STATE_ALIGNMENT_4
+                          : (W < 16 ? ITERATOR_INTERNAL_STATE_ALIGNMENT_8
+                                    : ITERATOR_INTERNAL_STATE_ALIGNMENT_16));
+  }
+
   template <int W>
   struct alignas(simd_alignment_for_width(W)) vfloatn
   {
@@ -172,7 +180,7 @@ namespace openvkl {
   template <int W>
   struct alignas(simd_alignment_for_width_with_ptr(W)) vVKLIntervalIteratorN
   {
-    alignas(simd_alignment_for_width(
+    alignas(iterator_internal_state_alignment_for_width(
         W)) char internalState[iterator_internal_state_size_for_width(W)];
     VKLVolume volume;
 
@@ -186,41 +194,26 @@ namespace openvkl {
              iterator_internal_state_size_for_width(W));
     }
 
-    // vVKLIntervalIteratorN<1> is maximally sized, so can hold internal state
-    // for any other iterator width; this is to support execution of the
-    // scalar APIs through the native vector-wide implementation. therefore we
-    // allow conversion between width=1 and any other width.
-    //
-    // any width => scalar conversion
-    explicit operator vVKLIntervalIteratorN<1>()
+    // vVKLIntervalIteratorN<1> is maximally sized and aligned, so can hold the
+    // internal state of any other iterator width in place; this is to support
+    // execution of the scalar APIs through the native vector-wide
+    // implementation without copying iterator state. only the internal state
+    // of the returned wide view is meaningful: its volume member overlaps the
+    // unused tail of this iterator's internal state (or, for the widest width,
+    // this iterator's volume member).
+    template <int W2>
+    vVKLIntervalIteratorN<W2> &asWidth()
     {
-      static_assert(iterator_internal_state_size_for_width(1) >=
-                        iterator_internal_state_size_for_width(W),
+      static_assert(W == 1, "only scalar iterators can hold wider types");
+      static_assert(sizeof(vVKLIntervalIteratorN<W2>) <=
+                        sizeof(vVKLIntervalIteratorN<W>),
                     "vVKLIntervalIteratorN<1> is not sufficiently sized to "
                     "hold wider type");
-
-      vVKLIntervalIteratorN<1> iterator1;
-      memcpy(iterator1.internalState,
-             internalState,
-             iterator_internal_state_size_for_width(W));
-      iterator1.volume = volume;
-      return iterator1;
-    }
-
-    // scalar (width 1) => any width conversion
-    template <int W2, typename = std::enable_if<(W == 1 && W2 != W)>>
-    explicit operator vVKLIntervalIteratorN<W2>()
-    {
-      static_assert(iterator_internal_state_size_for_width(W2) <=
-                        iterator_internal_state_size_for_width(W),
-                    "vVKLIntervalIteratorN<W2> is larger than source type");
-
-      vVKLIntervalIteratorN<W2> iteratorW2;
-      memcpy(iteratorW2.internalState,
-             internalState,
-             iterator_internal_state_size_for_width(W2));
-      iteratorW2.volume = volume;
-      return iteratorW2;
+      static_assert(alignof(vVKLIntervalIteratorN<W2>) <=
+                        alignof(vVKLIntervalIteratorN<W>),
+                    "vVKLIntervalIteratorN<1> is not sufficiently aligned to "
+                    "hold wider type");
+      return reinterpret_cast<vVKLIntervalIteratorN<W2> &>(*this);
     }
 
     template <int W2 = W, typename = std::enable_if<(W == 1)>>
@@ -350,7 +343,7 @@ namespace openvkl {
   template <int W>
   struct alignas(simd_alignment_for_width_with_ptr(W)) vVKLHitIteratorN
   {
-    alignas(simd_alignment_for_width(
+    alignas(iterator_internal_state_alignment_for_width(
         W)) char internalState[iterator_internal_state_size_for_width(W)];
     VKLVolume volume;
 
@@ -363,41 +356,26 @@ namespace openvkl {
              iterator_internal_state_size_for_width(W));
     }
 
-    // vVKLHitIteratorN<1> is maximally sized, so can hold internal state for
-    // any other iterator width; this is to support execution of the scalar
-    // APIs through the native vector-wide implementation. therefore we allow
-    // conversion between width=1 and any other width.
-    //
-    // any width => scalar conversion
-    explicit operator vVKLHitIteratorN<1>()
-    {
-      static_assert(
-          iterator_internal_state_size_for_width(1) >=
-              iterator_internal_state_size_for_width(W),
-          "vVKLHitIteratorN<1> is not sufficiently sized to hold wider type");
-
-      vVKLHitIteratorN<1> iterator1;
-      memcpy(iterator1.internalState,
-             internalState,
-             iterator_internal_state_size_for_width(W));
-      iterator1.volume = volume;
-      return iterator1;
-    }
-
-    // scalar (width 1) => any width conversion
-    template <int W2, typename = std::enable_if<(W == 1 && W2 != W)>>
-    explicit operator vVKLHitIteratorN<W2>()
-    {
-      static_assert(iterator_internal_state_size_for_width(W2) <=
-                        iterator_internal_state_size_for_width(W),
-                    "vVKLHitIteratorN<W2> is larger than source type");
-
-      vVKLHitIteratorN<W2> iteratorW2;
-      memcpy(iteratorW2.internalState,
-             internalState,
-             iterator_internal_state_size_for_width(W2));
-      iteratorW2.volume = volume;
-      return iteratorW2;
+    // vVKLHitIteratorN<1> is maximally sized and aligned, so can hold the
+    // internal state of any other iterator width in place; this is to support
+    // execution of the scalar APIs through the native vector-wide
+    // implementation without copying iterator state. only the internal state
+    // of the returned wide view is meaningful: its volume member overlaps the
+    // unused tail of this iterator's internal state (or, for the widest width,
+    // this iterator's volume member).
+    template <int W2>
+    vVKLHitIteratorN<W2> &asWidth()
+    {
+      static_assert(W == 1, "only scalar iterators can hold wider types");
+      static_assert(sizeof(vVKLHitIteratorN<W2>) <=
+                        sizeof(vVKLHitIteratorN<W>),
+                    "vVKLHitIteratorN<1> is not sufficiently sized to "
+                    "hold wider type");
+      static_assert(alignof(vVKLHitIteratorN<W2>) <=
+                        alignof(vVKLHitIteratorN<W>),
+                    "vVKLHitIteratorN<1> is not sufficiently aligned to "
+                    "hold wider type");
+      return reinterpret_cast<vVKLHitIteratorN<W2> &>(*this);
     }
 
     template <int W2 = W, typename = std::enable_if<(W == 1)>>
@@ -73,6 +73,13 @@ namespace openvkl {
     // Interval iterator //////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
 
+    template <int W>
+    size_t ISPCDriver<W>::getIntervalIteratorSize(VKLVolume volume)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+      return volumeObject.getIntervalIteratorSize();
+    }
+
 #define __define_initIntervalIteratorN(WIDTH)                               \
   template <int W>                                                          \
   void ISPCDriver<W>::initIntervalIterator##WIDTH(                          \
@@ -117,6 +124,13 @@ namespace openvkl {
     // Hit iterator ///////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
 
+    template <int W>
+    size_t ISPCDriver<W>::getHitIteratorSize(VKLVolume volume)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+      return volumeObject.getHitIteratorSize();
+    }
+
 #define __define_initHitIteratorN(WIDTH)                                    \
   template <int W>                                                          \
   void ISPCDriver<W>::initHitIterator##WIDTH(                               \
@@ -298,6 +312,32 @@ namespace openvkl {
 
 #undef __define_computeSampleN
 
+    template <int W>
+    void ISPCDriver<W>::computeSampleStream(VKLVolume volume,
+                                            size_t count,
+                                            const vec3f *objectCoordinates,
+                                            float *samples)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+      volumeObject.computeSampleStream(count, objectCoordinates, samples);
+    }
+
+    template <int W>
+    void ISPCDriver<W>::computeSampleStreamSoA(VKLVolume volume,
+                                               size_t count,
+                                               const float *objectCoordinatesX,
+                                               const float *objectCoordinatesY,
+                                               const float *objectCoordinatesZ,
+                                               float *samples)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+      volumeObject.computeSampleStreamSoA(count,
+                                          objectCoordinatesX,
+                                          objectCoordinatesY,
+                                          objectCoordinatesZ,
+                                          samples);
+    }
+
 #define __define_computeGradientN(WIDTH)              \
   template <int W>                                    \
   void ISPCDriver<W>::computeGradient##WIDTH(         \
@@ -317,6 +357,54 @@ namespace openvkl {
 
 #undef __define_computeGradientN
 
+#define __define_computeSampleAndGradientN(WIDTH)              \
+  template <int W>                                             \
+  void ISPCDriver<W>::computeSampleAndGradient##WIDTH(         \
+      const int *valid,                                        \
+      VKLVolume volume,                                        \
+      const vvec3fn<WIDTH> &objectCoordinates,                 \
+      vfloatn<WIDTH> &samples,                                 \
+      vvec3fn<WIDTH> &gradients)                               \
+  {                                                            \
+    computeSampleAndGradientAnyWidth<WIDTH>(                   \
+        valid, volume, objectCoordinates, samples, gradients); \
+  }
+
+    __define_computeSampleAndGradientN(1);
+    __define_computeSampleAndGradientN(4);
+    __define_computeSampleAndGradientN(8);
+    __define_computeSampleAndGradientN(16);
+
+#undef __define_computeSampleAndGradientN
+
+#define __define_computeSampleMN(WIDTH)                                  \
+  template <int W>                                                       \
+  void ISPCDriver<W>::computeSampleM##WIDTH(                             \
+      const int *valid,                                                  \
+      VKLVolume volume,                                                  \
+      const vvec3fn<WIDTH> &objectCoordinates,                           \
+      float *samples,                                                    \
+      unsigned int M,                                                    \
+      const unsigned int *attributeIndices)                              \
+  {                                                                      \
+    computeSampleMAnyWidth<WIDTH>(                                       \
+        valid, volume, objectCoordinates, samples, M, attributeIndices); \
+  }
+
+    __define_computeSampleMN(1);
+    __define_computeSampleMN(4);
+    __define_computeSampleMN(8);
+    __define_computeSampleMN(16);
+
+#undef __define_computeSampleMN
+
+    template <int W>
+    unsigned int ISPCDriver<W>::getNumAttributes(VKLVolume volume)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+      return volumeObject.getNumAttributes();
+    }
+
     template <int W>
     box3f ISPCDriver<W>::getBoundingBox(VKLVolume volume)
     {
@@ -324,6 +412,14 @@ namespace openvkl {
       return volumeObject.getBoundingBox();
     }
 
+    template <int W>
+    void ISPCDriver<W>::updateVolumeRegion(VKLVolume volume,
+                                           const box3i &region)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+      volumeObject.updateRegion(region);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Private methods ////////////////////////////////////////////////////////
     ///////////////////////////////////////////////////////////////////////////
@@ -350,17 +446,17 @@ namespace openvkl {
       vvec3fn<W> directionW = static_cast<vvec3fn<W>>(direction);
       vrange1fn<W> tRangeW  = static_cast<vrange1fn<W>>(tRange);
 
-      vVKLIntervalIteratorN<W> iteratorW;
-
+      // the native-width iterator is constructed in place in the scalar
+      // iterator's internal state
       volumeObject.initIntervalIteratorV(
           validW,
-          iteratorW,
+          iterator.template asWidth<W>(),
           originW,
           directionW,
           tRangeW,
           reinterpret_cast<const ValueSelector<W> *>(valueSelector));
 
-      iterator = static_cast<vVKLIntervalIteratorN<1>>(iteratorW);
+      iterator.volume = volume;
     }
 
     template <int W>
@@ -429,12 +525,8 @@ namespace openvkl {
 
       vintn<W> resultW;
 
-      vVKLIntervalIteratorN<W> iteratorW =
-          static_cast<vVKLIntervalIteratorN<W>>(iterator1);
-
-      volumeObject.iterateIntervalV(validW, iteratorW, intervalW, resultW);
-
-      iterator1 = static_cast<vVKLIntervalIteratorN<1>>(iteratorW);
+      volumeObject.iterateIntervalV(
+          validW, iterator1.template asWidth<W>(), intervalW, resultW);
 
       for (int i = 0; i < OW; i++) {
         interval.tRange.lower[i]     = intervalW.tRange.lower[i];
@@ -514,17 +606,17 @@ namespace openvkl {
       vvec3fn<W> directionW = static_cast<vvec3fn<W>>(direction);
       vrange1fn<W> tRangeW  = static_cast<vrange1fn<W>>(tRange);
 
-      vVKLHitIteratorN<W> iteratorW;
-
+      // the native-width iterator is constructed in place in the scalar
+      // iterator's internal state
       volumeObject.initHitIteratorV(
           validW,
-          iteratorW,
+          iterator.template asWidth<W>(),
           originW,
           directionW,
           tRangeW,
           reinterpret_cast<const ValueSelector<W> *>(valueSelector));
 
-      iterator = static_cast<vVKLHitIteratorN<1>>(iteratorW);
+      iterator.volume = volume;
     }
 
     template <int W>
@@ -591,12 +683,8 @@ namespace openvkl {
 
       vintn<W> resultW;
 
-      vVKLHitIteratorN<W> iteratorW =
-          static_cast<vVKLHitIteratorN<W>>(iterator1);
-
-      volumeObject.iterateHitV(validW, iteratorW, hitW, resultW);
-
-      iterator1 = static_cast<vVKLHitIteratorN<1>>(iteratorW);
+      volumeObject.iterateHitV(
+          validW, iterator1.template asWidth<W>(), hitW, resultW);
 
       for (int i = 0; i < OW; i++) {
         hit.t[i]      = hitW.t[i];
@@ -651,7 +739,24 @@ namespace openvkl {
 
     template <int W>
     template <int OW>
-    typename std::enable_if<(OW <= W), void>::type
+    typename std::enable_if<(OW == 1), void>::type
+    ISPCDriver<W>::computeSampleAnyWidth(const int *valid,
+                                         VKLVolume volume,
+                                         const vvec3fn<OW> &objectCoordinates,
+                                         vfloatn<OW> &samples)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+
+      if (valid[0]) {
+        samples[0] = volumeObject.computeSample(vec3f(objectCoordinates.x[0],
+                                                      objectCoordinates.y[0],
+                                                      objectCoordinates.z[0]));
+      }
+    }
+
+    template <int W>
+    template <int OW>
+    typename std::enable_if<(OW != 1 && OW <= W), void>::type
     ISPCDriver<W>::computeSampleAnyWidth(const int *valid,
                                          VKLVolume volume,
                                          const vvec3fn<OW> &objectCoordinates,
@@ -759,6 +864,203 @@ namespace openvkl {
       }
     }
 
+    template <int W>
+    template <int OW>
+    typename std::enable_if<(OW == 1), void>::type
+    ISPCDriver<W>::computeSampleAndGradientAnyWidth(
+        const int *valid,
+        VKLVolume volume,
+        const vvec3fn<OW> &objectCoordinates,
+        vfloatn<OW> &samples,
+        vvec3fn<OW> &gradients)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+
+      if (valid[0]) {
+        vec3f gradient;
+        samples[0] = volumeObject.computeSampleAndGradient(
+            vec3f(objectCoordinates.x[0],
+                  objectCoordinates.y[0],
+                  objectCoordinates.z[0]),
+            gradient);
+
+        gradients.x[0] = gradient.x;
+        gradients.y[0] = gradient.y;
+        gradients.z[0] = gradient.z;
+      }
+    }
+
+    template <int W>
+    template <int OW>
+    typename std::enable_if<(OW != 1 && OW <= W), void>::type
+    ISPCDriver<W>::computeSampleAndGradientAnyWidth(
+        const int *valid,
+        VKLVolume volume,
+        const vvec3fn<OW> &objectCoordinates,
+        vfloatn<OW> &samples,
+        vvec3fn<OW> &gradients)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+
+      vvec3fn<W> ocW = static_cast<vvec3fn<W>>(objectCoordinates);
+
+      vintn<W> validW;
+      for (int i = 0; i < W; i++)
+        validW[i] = i < OW ? valid[i] : 0;
+
+      vfloatn<W> samplesW;
+      vvec3fn<W> gradientsW;
+
+      volumeObject.computeSampleAndGradientV(
+          validW, ocW, samplesW, gradientsW);
+
+      for (int i = 0; i < OW; i++) {
+        samples[i]     = samplesW[i];
+        gradients.x[i] = gradientsW.x[i];
+        gradients.y[i] = gradientsW.y[i];
+        gradients.z[i] = gradientsW.z[i];
+      }
+    }
+
+    template <int W>
+    template <int OW>
+    typename std::enable_if<(OW > W), void>::type
+    ISPCDriver<W>::computeSampleAndGradientAnyWidth(
+        const int *valid,
+        VKLVolume volume,
+        const vvec3fn<OW> &objectCoordinates,
+        vfloatn<OW> &samples,
+        vvec3fn<OW> &gradients)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+
+      const int numPacks = OW / W + (OW % W != 0);
+
+      for (int packIndex = 0; packIndex < numPacks; packIndex++) {
+        vvec3fn<W> ocW = objectCoordinates.template extract_pack<W>(packIndex);
+
+        vintn<W> validW;
+        for (int i = packIndex * W; i < (packIndex + 1) * W && i < OW; i++)
+          validW[i - packIndex * W] = i < OW ? valid[i] : 0;
+
+        vfloatn<W> samplesW;
+        vvec3fn<W> gradientsW;
+
+        volumeObject.computeSampleAndGradientV(
+            validW, ocW, samplesW, gradientsW);
+
+        for (int i = packIndex * W; i < (packIndex + 1) * W && i < OW; i++) {
+          samples[i]     = samplesW[i - packIndex * W];
+          gradients.x[i] = gradientsW.x[i - packIndex * W];
+          gradients.y[i] = gradientsW.y[i - packIndex * W];
+          gradients.z[i] = gradientsW.z[i - packIndex * W];
+        }
+      }
+    }
+
+    // maximum number of attributes sampled per call into the volume when
+    // samples need to be repacked between widths
+    static constexpr unsigned int maxAttributesPerPass = 16;
+
+    static void validateAttributeIndices(unsigned int numAttributes,
+                                         unsigned int M,
+                                         const unsigned int *attributeIndices)
+    {
+      for (unsigned int i = 0; i < M; i++) {
+        if (attributeIndices[i] >= numAttributes) {
+          throw std::runtime_error("invalid attribute index " +
+                                   std::to_string(attributeIndices[i]));
+        }
+      }
+    }
+
+    template <int W>
+    template <int OW>
+    typename std::enable_if<(OW <= W), void>::type
+    ISPCDriver<W>::computeSampleMAnyWidth(const int *valid,
+                                          VKLVolume volume,
+                                          const vvec3fn<OW> &objectCoordinates,
+                                          float *samples,
+                                          unsigned int M,
+                                          const unsigned int *attributeIndices)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+
+      validateAttributeIndices(
+          volumeObject.getNumAttributes(), M, attributeIndices);
+
+      vvec3fn<W> ocW = static_cast<vvec3fn<W>>(objectCoordinates);
+
+      vintn<W> validW;
+      for (int i = 0; i < W; i++)
+        validW[i] = i < OW ? valid[i] : 0;
+
+      if (OW == W) {
+        volumeObject.computeSampleMV(validW, ocW, M, attributeIndices, samples);
+        return;
+      }
+
+      alignas(64) float samplesW[maxAttributesPerPass * W];
+
+      for (unsigned int first = 0; first < M; first += maxAttributesPerPass) {
+        const unsigned int count = std::min(M - first, maxAttributesPerPass);
+
+        volumeObject.computeSampleMV(
+            validW, ocW, count, attributeIndices + first, samplesW);
+
+        for (unsigned int a = 0; a < count; a++) {
+          for (int i = 0; i < OW; i++)
+            samples[(first + a) * OW + i] = samplesW[a * W + i];
+        }
+      }
+    }
+
+    template <int W>
+    template <int OW>
+    typename std::enable_if<(OW > W), void>::type
+    ISPCDriver<W>::computeSampleMAnyWidth(const int *valid,
+                                          VKLVolume volume,
+                                          const vvec3fn<OW> &objectCoordinates,
+                                          float *samples,
+                                          unsigned int M,
+                                          const unsigned int *attributeIndices)
+    {
+      auto &volumeObject = referenceFromHandle<Volume<W>>(volume);
+
+      validateAttributeIndices(
+          volumeObject.getNumAttributes(), M, attributeIndices);
+
+      alignas(64) float samplesW[maxAttributesPerPass * W];
+
+      const int numPacks = OW / W + (OW % W != 0);
+
+      for (int packIndex = 0; packIndex < numPacks; packIndex++) {
+        vvec3fn<W> ocW = objectCoordinates.template extract_pack<W>(packIndex);
+
+        vintn<W> validW;
+        for (int i = 0; i < W; i++) {
+          const int o = packIndex * W + i;
+          validW[i]   = o < OW ? valid[o] : 0;
+        }
+
+        for (unsigned int first = 0; first < M;
+             first += maxAttributesPerPass) {
+          const unsigned int count =
+              std::min(M - first, maxAttributesPerPass);
+
+          volumeObject.computeSampleMV(
+              validW, ocW, count, attributeIndices + first, samplesW);
+
+          for (unsigned int a = 0; a < count; a++) {
+            for (int i = packIndex * W; i < (packIndex + 1) * W && i < OW;
+                 i++)
+              samples[(first + a) * OW + i] =
+                  samplesW[a * W + i - packIndex * W];
+          }
+        }
+      }
+    }
+
     VKL_REGISTER_DRIVER(ISPCDriver<4>, ispc_4)
     VKL_REGISTER_DRIVER(ISPCDriver<8>, ispc_8)
     VKL_REGISTER_DRIVER(ISPCDriver<16>, ispc_16)
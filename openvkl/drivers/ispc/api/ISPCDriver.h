@@ -50,6 +50,8 @@ namespace openvkl {
       // Interval iterator ////////////////////////////////////////////////////
       /////////////////////////////////////////////////////////////////////////
 
+      size_t getIntervalIteratorSize(VKLVolume volume) override;
+
 #define __define_initIntervalIteratorN(WIDTH)                              \
   void initIntervalIterator##WIDTH(const int *valid,                       \
                                    vVKLIntervalIteratorN<WIDTH> &iterator, \
@@ -83,6 +85,8 @@ namespace openvkl {
       // Hit iterator /////////////////////////////////////////////////////////
       /////////////////////////////////////////////////////////////////////////
 
+      size_t getHitIteratorSize(VKLVolume volume) override;
+
 #define __define_initHitIteratorN(WIDTH)                         \
   void initHitIterator##WIDTH(const int *valid,                  \
                               vVKLHitIteratorN<WIDTH> &iterator, \
@@ -172,6 +176,18 @@ namespace openvkl {
 
 #undef __define_computeSampleN
 
+      void computeSampleStream(VKLVolume volume,
+                               size_t count,
+                               const vec3f *objectCoordinates,
+                               float *samples) override;
+
+      void computeSampleStreamSoA(VKLVolume volume,
+                                  size_t count,
+                                  const float *objectCoordinatesX,
+                                  const float *objectCoordinatesY,
+                                  const float *objectCoordinatesZ,
+                                  float *samples) override;
+
 #define __define_computeGradientN(WIDTH)                               \
   void computeGradient##WIDTH(const int *valid,                        \
                               VKLVolume volume,                        \
@@ -185,8 +201,43 @@ namespace openvkl {
 
 #undef __define_computeGradientN
 
+#define __define_computeSampleAndGradientN(WIDTH)            \
+  void computeSampleAndGradient##WIDTH(                      \
+      const int *valid,                                      \
+      VKLVolume volume,                                      \
+      const vvec3fn<WIDTH> &objectCoordinates,               \
+      vfloatn<WIDTH> &samples,                               \
+      vvec3fn<WIDTH> &gradients) override;
+
+      __define_computeSampleAndGradientN(1);
+      __define_computeSampleAndGradientN(4);
+      __define_computeSampleAndGradientN(8);
+      __define_computeSampleAndGradientN(16);
+
+#undef __define_computeSampleAndGradientN
+
+#define __define_computeSampleMN(WIDTH)        \
+  void computeSampleM##WIDTH(                  \
+      const int *valid,                        \
+      VKLVolume volume,                        \
+      const vvec3fn<WIDTH> &objectCoordinates, \
+      float *samples,                          \
+      unsigned int M,                          \
+      const unsigned int *attributeIndices) override;
+
+      __define_computeSampleMN(1);
+      __define_computeSampleMN(4);
+      __define_computeSampleMN(8);
+      __define_computeSampleMN(16);
+
+#undef __define_computeSampleMN
+
+      unsigned int getNumAttributes(VKLVolume volume) override;
+
       box3f getBoundingBox(VKLVolume volume) override;
 
+      void updateVolumeRegion(VKLVolume volume, const box3i &region) override;
+
      private:
       template <int OW>
       typename std::enable_if<(OW == 1), void>::type
@@ -291,12 +342,19 @@ namespace openvkl {
                          vintn<OW> &result);
 
       template <int OW>
-      typename std::enable_if<(OW <= W), void>::type computeSampleAnyWidth(
+      typename std::enable_if<(OW == 1), void>::type computeSampleAnyWidth(
           const int *valid,
           VKLVolume volume,
           const vvec3fn<OW> &objectCoordinates,
           vfloatn<OW> &samples);
 
+      template <int OW>
+      typename std::enable_if<(OW != 1 && OW <= W), void>::type
+      computeSampleAnyWidth(const int *valid,
+                            VKLVolume volume,
+                            const vvec3fn<OW> &objectCoordinates,
+                            vfloatn<OW> &samples);
+
       template <int OW>
       typename std::enable_if<(OW > W), void>::type computeSampleAnyWidth(
           const int *valid,
@@ -317,6 +375,48 @@ namespace openvkl {
           VKLVolume volume,
           const vvec3fn<OW> &objectCoordinates,
           vvec3fn<OW> &gradients);
+
+      template <int OW>
+      typename std::enable_if<(OW == 1), void>::type
+      computeSampleAndGradientAnyWidth(const int *valid,
+                                       VKLVolume volume,
+                                       const vvec3fn<OW> &objectCoordinates,
+                                       vfloatn<OW> &samples,
+                                       vvec3fn<OW> &gradients);
+
+      template <int OW>
+      typename std::enable_if<(OW != 1 && OW <= W), void>::type
+      computeSampleAndGradientAnyWidth(const int *valid,
+                                       VKLVolume volume,
+                                       const vvec3fn<OW> &objectCoordinates,
+                                       vfloatn<OW> &samples,
+                                       vvec3fn<OW> &gradients);
+
+      template <int OW>
+      typename std::enable_if<(OW > W), void>::type
+      computeSampleAndGradientAnyWidth(const int *valid,
+                                       VKLVolume volume,
+                                       const vvec3fn<OW> &objectCoordinates,
+                                       vfloatn<OW> &samples,
+                                       vvec3fn<OW> &gradients);
+
+      template <int OW>
+      typename std::enable_if<(OW <= W), void>::type computeSampleMAnyWidth(
+          const int *valid,
+          VKLVolume volume,
+          const vvec3fn<OW> &objectCoordinates,
+          float *samples,
+          unsigned int M,
+          const unsigned int *attributeIndices);
+
+      template <int OW>
+      typename std::enable_if<(OW > W), void>::type computeSampleMAnyWidth(
+          const int *valid,
+          VKLVolume volume,
+          const vvec3fn<OW> &objectCoordinates,
+          float *samples,
+          unsigned int M,
+          const unsigned int *attributeIndices);
     };
 
   }  // namespace ispc_driver
@@ -33,21 +33,13 @@ namespace openvkl {
                                         const vvec3fn<W> &direction,
                                         const vrange1fn<W> &tRange,
                                         const ValueSelector<W> *valueSelector)
-        : Iterator<W>(valid, volume, origin, direction, tRange, valueSelector)
     {
       static bool oneTimeChecks = false;
 
       if (!oneTimeChecks) {
-        int ispcSize = ispc::DefaultIterator_sizeOf();
-
-        if (ispcSize > ispcStorageSize) {
-          LogMessageStream(VKL_LOG_ERROR)
-              << "DefaultIterator required ISPC object size = " << ispcSize
-              << ", allocated size = " << ispcStorageSize << std::endl;
-
-          throw std::runtime_error(
-              "DefaultIterator has insufficient ISPC storage");
-        }
+        checkIteratorISPCStorage("DefaultIterator",
+                                 ispc::DefaultIterator_sizeOf(),
+                                 ispcStorageSize);
 
         oneTimeChecks = true;
       }
@@ -68,38 +60,31 @@ namespace openvkl {
           (const ispc::box1f &)valueRange);
     }
 
-    template <int W>
-    const Interval<W> *DefaultIterator<W>::getCurrentInterval() const
-    {
-      return reinterpret_cast<const Interval<W> *>(
-          ispc::DefaultIterator_getCurrentInterval((void *)&ispcStorage[0]));
-    }
-
     template <int W>
     void DefaultIterator<W>::iterateInterval(const vintn<W> &valid,
+                                             vVKLIntervalN<W> &interval,
                                              vintn<W> &result)
     {
-      ispc::DefaultIterator_iterateInterval(
-          (const int *)&valid, (void *)&ispcStorage[0], (int *)&result);
-    }
-
-    template <int W>
-    const Hit<W> *DefaultIterator<W>::getCurrentHit() const
-    {
-      return reinterpret_cast<const Hit<W> *>(
-          ispc::DefaultIterator_getCurrentHit((void *)&ispcStorage[0]));
+      ispc::DefaultIterator_iterateInterval((const int *)&valid,
+                                            (void *)&ispcStorage[0],
+                                            (void *)&interval,
+                                            (int *)&result);
     }
 
     template <int W>
-    void DefaultIterator<W>::iterateHit(const vintn<W> &valid, vintn<W> &result)
+    void DefaultIterator<W>::iterateHit(const vintn<W> &valid,
+                                        vVKLHitN<W> &hit,
+                                        vintn<W> &result)
     {
-      ispc::DefaultIterator_iterateHit(
-          (const int *)&valid, (void *)&ispcStorage[0], (int *)&result);
+      ispc::DefaultIterator_iterateHit((const int *)&valid,
+                                       (void *)&ispcStorage[0],
+                                       (void *)&hit,
+                                       (int *)&result);
     }
 
-    template class DefaultIterator<4>;
-    template class DefaultIterator<8>;
-    template class DefaultIterator<16>;
+    template struct DefaultIterator<4>;
+    template struct DefaultIterator<8>;
+    template struct DefaultIterator<16>;
 
   }  // namespace ispc_driver
 }  // namespace openvkl
@@ -22,13 +22,8 @@ namespace openvkl {
   namespace ispc_driver {
 
     template <int W>
-    struct Volume;
-
-    template <int W>
-    struct DefaultIterator : public Iterator<W>
+    struct DefaultIterator
     {
-      DefaultIterator() {}
-
       DefaultIterator(const vintn<W> &valid,
                       const Volume<W> *volume,
                       const vvec3fn<W> &origin,
@@ -36,14 +31,16 @@ namespace openvkl {
                       const vrange1fn<W> &tRange,
                       const ValueSelector<W> *valueSelector);
 
-      const Interval<W> *getCurrentInterval() const override;
-      void iterateInterval(const vintn<W> &valid, vintn<W> &result) override;
+      void iterateInterval(const vintn<W> &valid,
+                           vVKLIntervalN<W> &interval,
+                           vintn<W> &result);
 
-      const Hit<W> *getCurrentHit() const override;
-      void iterateHit(const vintn<W> &valid, vintn<W> &result) override;
+      void iterateHit(const vintn<W> &valid,
+                      vVKLHitN<W> &hit,
+                      vintn<W> &result);
 
       // required size of ISPC-side object for width
-      static constexpr int ispcStorageSize = 124 * W;
+      static constexpr int ispcStorageSize = 40 * W;
 
      protected:
       alignas(simd_alignment_for_width(W)) char ispcStorage[ispcStorageSize];
@@ -23,33 +23,29 @@
 namespace openvkl {
   namespace ispc_driver {
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Interval iterator //////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
     template <int W>
-    constexpr int GridAcceleratorIterator<W>::ispcStorageSize;
+    constexpr int GridAcceleratorIntervalIterator<W>::ispcStorageSize;
 
     template <int W>
-    GridAcceleratorIterator<W>::GridAcceleratorIterator(
+    GridAcceleratorIntervalIterator<W>::GridAcceleratorIntervalIterator(
         const vintn<W> &valid,
         const Volume<W> *volume,
         const vvec3fn<W> &origin,
         const vvec3fn<W> &direction,
         const vrange1fn<W> &tRange,
         const ValueSelector<W> *valueSelector)
-        : Iterator<W>(valid, volume, origin, direction, tRange, valueSelector)
     {
       static bool oneTimeChecks = false;
 
       if (!oneTimeChecks) {
-        int ispcSize = ispc::GridAcceleratorIterator_sizeOf();
-
-        if (ispcSize > ispcStorageSize) {
-          LogMessageStream(VKL_LOG_ERROR)
-              << "GridAcceleratorIterator required ISPC object size = "
-              << ispcSize << ", allocated size = " << ispcStorageSize
-              << std::endl;
-
-          throw std::runtime_error(
-              "GridAcceleratorIterator has insufficient ISPC storage");
-        }
+        checkIteratorISPCStorage(
+            "GridAcceleratorIntervalIterator",
+            ispc::GridAcceleratorIntervalIterator_sizeOf(),
+            ispcStorageSize);
 
         oneTimeChecks = true;
       }
@@ -57,9 +53,7 @@ namespace openvkl {
       const StructuredRegularVolume<W> *srv =
           static_cast<const StructuredRegularVolume<W> *>(volume);
 
-      box3f boundingBox = volume->getBoundingBox();
-
-      ispc::GridAcceleratorIterator_Initialize(
+      ispc::GridAcceleratorIntervalIterator_Initialize(
           (const int *)&valid,
           &ispcStorage[0],
           srv->getISPCEquivalent(),
@@ -70,39 +64,73 @@ namespace openvkl {
     }
 
     template <int W>
-    const Interval<W> *GridAcceleratorIterator<W>::getCurrentInterval() const
+    void GridAcceleratorIntervalIterator<W>::iterateInterval(
+        const vintn<W> &valid, vVKLIntervalN<W> &interval, vintn<W> &result)
     {
-      return reinterpret_cast<const Interval<W> *>(
-          ispc::GridAcceleratorIterator_getCurrentInterval(
-              (void *)&ispcStorage[0]));
+      ispc::GridAcceleratorIntervalIterator_iterateInterval(
+          (const int *)&valid,
+          (void *)&ispcStorage[0],
+          (void *)&interval,
+          (int *)&result);
     }
 
+    template struct GridAcceleratorIntervalIterator<4>;
+    template struct GridAcceleratorIntervalIterator<8>;
+    template struct GridAcceleratorIntervalIterator<16>;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Hit iterator ///////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
     template <int W>
-    void GridAcceleratorIterator<W>::iterateInterval(const vintn<W> &valid,
-                                                     vintn<W> &result)
-    {
-      ispc::GridAcceleratorIterator_iterateInterval(
-          (const int *)&valid, (void *)&ispcStorage[0], (int *)&result);
-    }
+    constexpr int GridAcceleratorHitIterator<W>::ispcStorageSize;
 
     template <int W>
-    const Hit<W> *GridAcceleratorIterator<W>::getCurrentHit() const
+    GridAcceleratorHitIterator<W>::GridAcceleratorHitIterator(
+        const vintn<W> &valid,
+        const Volume<W> *volume,
+        const vvec3fn<W> &origin,
+        const vvec3fn<W> &direction,
+        const vrange1fn<W> &tRange,
+        const ValueSelector<W> *valueSelector)
     {
-      return reinterpret_cast<const Hit<W> *>(
-          ispc::GridAcceleratorIterator_getCurrentHit((void *)&ispcStorage[0]));
+      static bool oneTimeChecks = false;
+
+      if (!oneTimeChecks) {
+        checkIteratorISPCStorage("GridAcceleratorHitIterator",
+                                 ispc::GridAcceleratorHitIterator_sizeOf(),
+                                 ispcStorageSize);
+
+        oneTimeChecks = true;
+      }
+
+      const StructuredRegularVolume<W> *srv =
+          static_cast<const StructuredRegularVolume<W> *>(volume);
+
+      ispc::GridAcceleratorHitIterator_Initialize(
+          (const int *)&valid,
+          &ispcStorage[0],
+          srv->getISPCEquivalent(),
+          (void *)&origin,
+          (void *)&direction,
+          (void *)&tRange,
+          valueSelector ? valueSelector->getISPCEquivalent() : nullptr);
     }
 
     template <int W>
-    void GridAcceleratorIterator<W>::iterateHit(const vintn<W> &valid,
-                                                vintn<W> &result)
+    void GridAcceleratorHitIterator<W>::iterateHit(const vintn<W> &valid,
+                                                   vVKLHitN<W> &hit,
+                                                   vintn<W> &result)
     {
-      ispc::GridAcceleratorIterator_iterateHit(
-          (const int *)&valid, (void *)&ispcStorage[0], (int *)&result);
+      ispc::GridAcceleratorHitIterator_iterateHit((const int *)&valid,
+                                                  (void *)&ispcStorage[0],
+                                                  (void *)&hit,
+                                                  (int *)&result);
     }
 
-    template class GridAcceleratorIterator<4>;
-    template class GridAcceleratorIterator<8>;
-    template class GridAcceleratorIterator<16>;
+    template struct GridAcceleratorHitIterator<4>;
+    template struct GridAcceleratorHitIterator<8>;
+    template struct GridAcceleratorHitIterator<16>;
 
   }  // namespace ispc_driver
 }  // namespace openvkl
@@ -22,28 +22,42 @@ namespace openvkl {
   namespace ispc_driver {
 
     template <int W>
-    struct Volume;
-
-    template <int W>
-    struct GridAcceleratorIterator : public Iterator<W>
+    struct GridAcceleratorIntervalIterator
     {
-      GridAcceleratorIterator() {}
+      GridAcceleratorIntervalIterator(const vintn<W> &valid,
+                                      const Volume<W> *volume,
+                                      const vvec3fn<W> &origin,
+                                      const vvec3fn<W> &direction,
+                                      const vrange1fn<W> &tRange,
+                                      const ValueSelector<W> *valueSelector);
+
+      void iterateInterval(const vintn<W> &valid,
+                           vVKLIntervalN<W> &interval,
+                           vintn<W> &result);
+
+      // required size of ISPC-side object for width
+      static constexpr int ispcStorageSize = 92 * W;
 
-      GridAcceleratorIterator(const vintn<W> &valid,
-                              const Volume<W> *volume,
-                              const vvec3fn<W> &origin,
-                              const vvec3fn<W> &direction,
-                              const vrange1fn<W> &tRange,
-                              const ValueSelector<W> *valueSelector);
+     protected:
+      alignas(simd_alignment_for_width(W)) char ispcStorage[ispcStorageSize];
+    };
 
-      const Interval<W> *getCurrentInterval() const override;
-      void iterateInterval(const vintn<W> &valid, vintn<W> &result) override;
+    template <int W>
+    struct GridAcceleratorHitIterator
+    {
+      GridAcceleratorHitIterator(const vintn<W> &valid,
+                                 const Volume<W> *volume,
+                                 const vvec3fn<W> &origin,
+                                 const vvec3fn<W> &direction,
+                                 const vrange1fn<W> &tRange,
+                                 const ValueSelector<W> *valueSelector);
 
-      const Hit<W> *getCurrentHit() const override;
-      void iterateHit(const vintn<W> &valid, vintn<W> &result) override;
+      void iterateHit(const vintn<W> &valid,
+                      vVKLHitN<W> &hit,
+                      vintn<W> &result);
 
       // required size of ISPC-side object for width
-      static constexpr int ispcStorageSize = 112 * W;
+      static constexpr int ispcStorageSize = 84 * W;
 
      protected:
       alignas(simd_alignment_for_width(W)) char ispcStorage[ispcStorageSize];
@@ -16,6 +16,10 @@
 
 #pragma once
 
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "../common/logging.h"
 #include "../common/simd.h"
 #include "../value_selector/ValueSelector.h"
 #include "openvkl/openvkl.h"
@@ -25,26 +29,19 @@ using namespace ospcommon;
 namespace openvkl {
   namespace ispc_driver {
 
-    template <int W, typename U>
-    inline vVKLIntervalIteratorN<W> toVKLIntervalIterator(U &&x)
-    {
-      static_assert(
-          iterator_internal_state_size_for_width(W) >= sizeof(U),
-          "iterator internal state size must be >= source object size");
-      vVKLIntervalIteratorN<W> result;
-      std::memcpy((void *)std::addressof(result.internalState),
-                  (const void *)std::addressof(x),
-                  sizeof(U));
-      result.volume = (VKLVolume)x.volume;
-      return result;
-    }
+    // iterators live in the internal state of the API iterator objects
+    // (VKLIntervalIterator, VKLHitIterator and their wide variants), and are
+    // dispatched to by the volume that created them. they hold nothing but
+    // their ISPC-side objects (no virtual functions or other C++ state), so
+    // that their size is determined by what they need to iterate. they are
+    // never destroyed, as the application owns and may discard the storage.
 
     template <typename T, int W>
     inline T *fromVKLIntervalIterator(vVKLIntervalIteratorN<W> *x)
     {
       static_assert(
-          alignof(T) == alignof(vVKLIntervalIteratorN<W>),
-          "alignment of destination type must be == alignment of source type");
+          alignof(T) <= alignof(vVKLIntervalIteratorN<W>),
+          "alignment of destination type must be <= alignment of source type");
       static_assert(
           sizeof(T) <= iterator_internal_state_size_for_width(W),
           "fromVKLIntervalIterator destination object size must be <= "
@@ -52,85 +49,63 @@ namespace openvkl {
       return reinterpret_cast<T *>(&x->internalState[0]);
     }
 
-    template <int W, typename U>
-    inline vVKLHitIteratorN<W> toVKLHitIterator(U &&x)
+    // constructs the iterator in place in the internal state of the API
+    // iterator, without any temporary copies
+    template <typename T, int W, typename... Args>
+    inline T *constructVKLIntervalIterator(vVKLIntervalIteratorN<W> &iterator,
+                                           VKLVolume volume,
+                                           Args &&... args)
     {
-      static_assert(
-          iterator_internal_state_size_for_width(W) >= sizeof(U),
-          "iterator internal state size must be >= source object size");
-      vVKLHitIteratorN<W> result;
-      std::memcpy((void *)std::addressof(result.internalState),
-                  (const void *)std::addressof(x),
-                  sizeof(U));
-      result.volume = (VKLVolume)x.volume;
-      return result;
+      static_assert(std::is_trivially_destructible<T>::value,
+                    "iterators must be trivially destructible");
+      T *t = new (fromVKLIntervalIterator<T>(&iterator))
+          T(std::forward<Args>(args)...);
+      iterator.volume = volume;
+      return t;
     }
 
     template <typename T, int W>
     inline T *fromVKLHitIterator(vVKLHitIteratorN<W> *x)
     {
       static_assert(
-          alignof(T) == alignof(vVKLHitIteratorN<W>),
-          "alignment of destination type must be == alignment of source type");
+          alignof(T) <= alignof(vVKLHitIteratorN<W>),
+          "alignment of destination type must be <= alignment of source type");
       static_assert(sizeof(T) <= iterator_internal_state_size_for_width(W),
                     "fromVKLHitIterator destination object size must be <= "
                     "iterator internal state size");
       return reinterpret_cast<T *>(&x->internalState[0]);
     }
 
-    template <int W>
-    struct Volume;
-
-    template <int W>
-    struct Interval
-    {
-      vrange1fn<W> tRange;
-      vrange1fn<W> valueRange;
-      vfloatn<W> nominalDeltaT;
-    };
-
-    template <int W>
-    struct Hit
+    template <typename T, int W, typename... Args>
+    inline T *constructVKLHitIterator(vVKLHitIteratorN<W> &iterator,
+                                      VKLVolume volume,
+                                      Args &&... args)
     {
-      vfloatn<W> t;
-      vfloatn<W> sample;
-    };
+      static_assert(std::is_trivially_destructible<T>::value,
+                    "iterators must be trivially destructible");
+      T *t = new (fromVKLHitIterator<T>(&iterator))
+          T(std::forward<Args>(args)...);
+      iterator.volume = volume;
+      return t;
+    }
 
-    // a general iterator that handles both interval and hit iteration
     template <int W>
-    struct Iterator
-    {
-      Iterator() = default;
-
-      Iterator(const vintn<W> &valid,
-               const Volume<W> *volume,
-               const vvec3fn<W> &origin,
-               const vvec3fn<W> &direction,
-               const vrange1fn<W> &tRange,
-               const ValueSelector<W> *valueSelector);
-
-      virtual ~Iterator() = default;
-
-      virtual const Interval<W> *getCurrentInterval() const                 = 0;
-      virtual void iterateInterval(const vintn<W> &valid, vintn<W> &result) = 0;
-
-      virtual const Hit<W> *getCurrentHit() const                      = 0;
-      virtual void iterateHit(const vintn<W> &valid, vintn<W> &result) = 0;
-
-      const Volume<W> *volume;
-    };
-
-    // Inlined definitions ////////////////////////////////////////////////////
+    struct Volume;
 
-    template <int W>
-    inline Iterator<W>::Iterator(const vintn<W> &valid,
-                                 const Volume<W> *volume,
-                                 const vvec3fn<W> &origin,
-                                 const vvec3fn<W> &direction,
-                                 const vrange1fn<W> &tRange,
-                                 const ValueSelector<W> *valueSelector)
-        : volume(volume)
+    // the ISPC-side object of an iterator must fit into the storage reserved
+    // for it; checked once per iterator type
+    inline void checkIteratorISPCStorage(const char *iteratorName,
+                                         int ispcSize,
+                                         int ispcStorageSize)
     {
+      if (ispcSize > ispcStorageSize) {
+        LogMessageStream(VKL_LOG_ERROR)
+            << iteratorName << " required ISPC object size = " << ispcSize
+            << ", allocated size = " << ispcStorageSize << std::endl;
+
+        throw std::runtime_error(std::string(iteratorName) +
+                                 " has insufficient ISPC storage");
+      }
     }
 
   }  // namespace ispc_driver
@@ -0,0 +1,135 @@
+// ======================================================================== //
+// Copyright 2019 Intel Corporation                                         //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "UnstructuredIterator.h"
+#include "../common/math.h"
+#include "../value_selector/ValueSelector.h"
+#include "../volume/UnstructuredVolume.h"
+#include "UnstructuredIterator_ispc.h"
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Interval iterator //////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    template <int W>
+    constexpr int UnstructuredIntervalIterator<W>::ispcStorageSize;
+
+    template <int W>
+    UnstructuredIntervalIterator<W>::UnstructuredIntervalIterator(
+        const vintn<W> &valid,
+        const Volume<W> *volume,
+        const vvec3fn<W> &origin,
+        const vvec3fn<W> &direction,
+        const vrange1fn<W> &tRange,
+        const ValueSelector<W> *valueSelector)
+    {
+      static bool oneTimeChecks = false;
+
+      if (!oneTimeChecks) {
+        checkIteratorISPCStorage("UnstructuredIntervalIterator",
+                                 ispc::UnstructuredIntervalIterator_sizeOf(),
+                                 ispcStorageSize);
+
+        oneTimeChecks = true;
+      }
+
+      const UnstructuredVolume<W> *uv =
+          static_cast<const UnstructuredVolume<W> *>(volume);
+
+      ispc::UnstructuredIntervalIterator_Initialize(
+          (const int *)&valid,
+          &ispcStorage[0],
+          uv->getISPCEquivalent(),
+          (void *)&origin,
+          (void *)&direction,
+          (void *)&tRange,
+          valueSelector ? valueSelector->getISPCEquivalent() : nullptr);
+    }
+
+    template <int W>
+    void UnstructuredIntervalIterator<W>::iterateInterval(
+        const vintn<W> &valid, vVKLIntervalN<W> &interval, vintn<W> &result)
+    {
+      ispc::UnstructuredIntervalIterator_iterateInterval(
+          (const int *)&valid,
+          (void *)&ispcStorage[0],
+          (void *)&interval,
+          (int *)&result);
+    }
+
+    template struct UnstructuredIntervalIterator<4>;
+    template struct UnstructuredIntervalIterator<8>;
+    template struct UnstructuredIntervalIterator<16>;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Hit iterator ///////////////////////////////////////////////////////////
+    ///////////////////////////////////////////////////////////////////////////
+
+    template <int W>
+    constexpr int UnstructuredHitIterator<W>::ispcStorageSize;
+
+    template <int W>
+    UnstructuredHitIterator<W>::UnstructuredHitIterator(
+        const vintn<W> &valid,
+        const Volume<W> *volume,
+        const vvec3fn<W> &origin,
+        const vvec3fn<W> &direction,
+        const vrange1fn<W> &tRange,
+        const ValueSelector<W> *valueSelector)
+    {
+      static bool oneTimeChecks = false;
+
+      if (!oneTimeChecks) {
+        checkIteratorISPCStorage("UnstructuredHitIterator",
+                                 ispc::UnstructuredHitIterator_sizeOf(),
+                                 ispcStorageSize);
+
+        oneTimeChecks = true;
+      }
+
+      const UnstructuredVolume<W> *uv =
+          static_cast<const UnstructuredVolume<W> *>(volume);
+
+      ispc::UnstructuredHitIterator_Initialize(
+          (const int *)&valid,
+          &ispcStorage[0],
+          uv->getISPCEquivalent(),
+          (void *)&origin,
+          (void *)&direction,
+          (void *)&tRange,
+          valueSelector ? valueSelector->getISPCEquivalent() : nullptr);
+    }
+
+    template <int W>
+    void UnstructuredHitIterator<W>::iterateHit(const vintn<W> &valid,
+                                                vVKLHitN<W> &hit,
+                                                vintn<W> &result)
+    {
+      ispc::UnstructuredHitIterator_iterateHit((const int *)&valid,
+                                               (void *)&ispcStorage[0],
+                                               (void *)&hit,
+                                               (int *)&result);
+    }
+
+    template struct UnstructuredHitIterator<4>;
+    template struct UnstructuredHitIterator<8>;
+    template struct UnstructuredHitIterator<16>;
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
@@ -15,12 +15,32 @@
 // ======================================================================== //
 
 #include "MinMaxBVH2.h"
+#include <algorithm>
+#include <array>
+#include "ospcommon/memory/malloc.h"
+#include "ospcommon/tasking/parallel_for.h"
 
 // num prims that _force_ a leaf; undef to revert to sah termination criterion
 //#define LEAF_THRESHOLD 2
 
 namespace openvkl {
 
+  // number of SAH bins along the split axis
+  static constexpr int numBins = 16;
+
+  // maximum number of primitives in a leaf, as encoded in the low bits of
+  // node references
+  static constexpr size_t maxLeafPrims = 7;
+
+  // maximum leaf depth; the traversal stacks in MinMaxBVH2.ispc and the
+  // unstructured volume iterators hold 32 entries
+  static constexpr int maxDepth = 31;
+
+  // primitive ranges of at least this size are binned and partitioned in
+  // parallel blocks, and their subtrees built as parallel tasks
+  static constexpr size_t parallelBlockSize     = 16384;
+  static constexpr size_t parallelTaskThreshold = 4096;
+
   template <typename T, int SIZE>
   inline float safeArea(const box_t<T, SIZE> &b)
   {
@@ -29,89 +49,377 @@ namespace openvkl {
     return std::max(std::fabs(f), 1e-20f);
   }
 
+  inline vec3f primCenter(const box4f &b)
+  {
+    return 0.5f * vec3f(b.lower.x + b.upper.x,
+                        b.lower.y + b.upper.y,
+                        b.lower.z + b.upper.z);
+  }
+
+  // smallest depth of a tree over numPrims primitives, split at the median
+  inline int balancedDepth(size_t numPrims)
+  {
+    int depth = 0;
+    while ((maxLeafPrims << depth) < numPrims)
+      depth++;
+    return depth;
+  }
+
+  // calls f(blockBegin, blockEnd, blockIndex) for blocks of [begin, end), in
+  // parallel for large ranges
+  template <typename F>
+  inline size_t forEachBlock(const size_t begin, const size_t end, F &&f)
+  {
+    const size_t numBlocks =
+        std::max(size_t(1), (end - begin + parallelBlockSize - 1) /
+                                parallelBlockSize);
+
+    auto block = [&](size_t blockIndex) {
+      const size_t blockBegin = begin + blockIndex * parallelBlockSize;
+      const size_t blockEnd   = std::min(end, blockBegin + parallelBlockSize);
+      f(blockBegin, blockEnd, blockIndex);
+    };
+
+    if (numBlocks == 1)
+      block(0);
+    else
+      tasking::parallel_for(numBlocks, block);
+
+    return numBlocks;
+  }
+
+  struct SAHBin
+  {
+    box4f bounds{empty};
+    box3f centerBounds{empty};
+    size_t count{0};
+
+    void extend(const SAHBin &other)
+    {
+      bounds.extend(other.bounds);
+      centerBounds.extend(other.centerBounds);
+      count += other.count;
+    }
+  };
+
+  // maps primitive centers along dim to bins; bins are recomputed with the
+  // same mapping when partitioning
+  struct SAHBinMapping
+  {
+    SAHBinMapping(const box3f &centerBounds, int dim)
+        : dim(dim),
+          lower(centerBounds.lower[dim]),
+          scale(numBins / (centerBounds.upper[dim] - centerBounds.lower[dim]))
+    {
+    }
+
+    int operator()(const vec3f &center) const
+    {
+      const float bin = (center[dim] - lower) * scale;
+      return std::max(int(std::min(bin, float(numBins - 1))), 0);
+    }
+
+    int dim;
+    float lower;
+    float scale;
+  };
+
+  MinMaxBVH2::RangeBounds MinMaxBVH2::computeRangeBounds(
+      const box4f *const primBounds,
+      const size_t begin,
+      const size_t end) const
+  {
+    std::vector<RangeBounds> blockBounds(
+        (end - begin + parallelBlockSize - 1) / parallelBlockSize + 1);
+
+    const size_t numBlocks = forEachBlock(
+        begin, end, [&](size_t blockBegin, size_t blockEnd, size_t block) {
+          for (size_t i = blockBegin; i < blockEnd; i++) {
+            blockBounds[block].bounds.extend(primBounds[primID[i]]);
+            blockBounds[block].centerBounds.extend(
+                primCenter(primBounds[primID[i]]));
+          }
+        });
+
+    RangeBounds rangeBounds;
+
+    for (size_t b = 0; b < numBlocks; b++) {
+      rangeBounds.bounds.extend(blockBounds[b].bounds);
+      rangeBounds.centerBounds.extend(blockBounds[b].centerBounds);
+    }
+
+    return rangeBounds;
+  }
+
   void MinMaxBVH2::buildRec(const size_t nodeID,
                             const box4f *const primBounds,
                             /*! tmp primid array, for non-inplace partition */
                             int64 *tmp_primID,
                             const size_t begin,
-                            const size_t end)
+                            const size_t end,
+                            const RangeBounds &rangeBounds,
+                            const int depth,
+                            std::atomic<size_t> &numNodes)
   {
-    box4f bounds4     = empty;
-    box4f centBounds4 = empty;
+    const size_t numPrims = end - begin;
 
-    union
-    {
-      vec3f as_vec3f;
-      vec4f as_vec4f;
-      float raw[4];
-    } ctr;
-
-    for (size_t i = begin; i < end; i++) {
-      bounds4.extend(primBounds[primID[i]]);
-      centBounds4.extend(center(primBounds[primID[i]]));
-    }
+    node[nodeID].lower = rangeBounds.bounds.lower;
+    node[nodeID].upper = rangeBounds.bounds.upper;
+
+    const box3f &centBounds = rangeBounds.centerBounds;
+
+    const int dim           = arg_max(centBounds.size());
+    const float extent      = centBounds.size()[dim];
+    const float costNoSplit = 1 + numPrims;
+
+    size_t mid = begin;
+    RangeBounds lBounds, rBounds;
 
-    node[nodeID].lower = bounds4.lower;
-    node[nodeID].upper = bounds4.upper;
+    // SAH splits are taken while the remaining depth allows for a balanced
+    // subtree below the larger child
+    const bool sahSplit =
+        extent > 0.f && depth + 1 + balancedDepth(numPrims) <= maxDepth;
 
-    const box3f centBounds((vec3f &)centBounds4.lower,
-                           (vec3f &)centBounds4.upper);
+    bool leaf = numPrims <= 1;
 
-    size_t dim        = arg_max(centBounds.size());
-    ctr.as_vec3f      = center(centBounds);
-    float pos         = ctr.raw[dim];
-    float costNoSplit = 1 + (end - begin);
+    if (!leaf && sahSplit) {
+      const SAHBinMapping mapping(centBounds, dim);
 
-    size_t l      = begin;
-    size_t r      = end;
-    box4f lBounds = empty;
-    box4f rBounds = empty;
+      std::vector<std::array<SAHBin, numBins>> blockBins(
+          (numPrims + parallelBlockSize - 1) / parallelBlockSize + 1);
+
+      const size_t numBlocks = forEachBlock(
+          begin, end, [&](size_t blockBegin, size_t blockEnd, size_t block) {
+            for (size_t i = blockBegin; i < blockEnd; i++) {
+              const box4f &b     = primBounds[primID[i]];
+              const vec3f center = primCenter(b);
+              SAHBin &bin        = blockBins[block][mapping(center)];
+              bin.bounds.extend(b);
+              bin.centerBounds.extend(center);
+              bin.count++;
+            }
+          });
+
+      std::array<SAHBin, numBins> bins;
+      for (size_t b = 0; b < numBlocks; b++)
+        for (int i = 0; i < numBins; i++)
+          bins[i].extend(blockBins[b][i]);
+
+      // sweep from the right, then find the cheapest split from the left
+      std::array<SAHBin, numBins> rightBins;
+      rightBins[numBins - 1] = bins[numBins - 1];
+      for (int i = numBins - 2; i >= 0; i--) {
+        rightBins[i] = rightBins[i + 1];
+        rightBins[i].extend(bins[i]);
+      }
+
+      const float rcpArea = 1.f / safeArea(rangeBounds.bounds);
+
+      int bestSplit     = 0;
+      float costIfSplit = inf;
+      SAHBin left;
+
+      for (int split = 1; split < numBins; split++) {
+        left.extend(bins[split - 1]);
+
+        if (left.count == 0 || rightBins[split].count == 0)
+          continue;
+
+        const float cost =
+            1 + rcpArea * (safeArea(left.bounds) * left.count +
+                           safeArea(rightBins[split].bounds) *
+                               rightBins[split].count);
+
+        if (cost < costIfSplit) {
+          costIfSplit = cost;
+          bestSplit   = split;
+        }
+      }
+
+      if (
+#ifdef LEAF_THRESHOLD
+          numPrims <= LEAF_THRESHOLD ||
+#endif
+          (costIfSplit >= costNoSplit && numPrims <= maxLeafPrims)) {
+        leaf = true;
+      } else if (bestSplit > 0) {
+        SAHBin leftBins;
+        for (int i = 0; i < bestSplit; i++)
+          leftBins.extend(bins[i]);
 
-    for (size_t i = begin; i < end; i++) {
-      ctr.as_vec4f = center(primBounds[primID[i]]);
+        lBounds.bounds       = leftBins.bounds;
+        lBounds.centerBounds = leftBins.centerBounds;
+        rBounds.bounds       = rightBins[bestSplit].bounds;
+        rBounds.centerBounds = rightBins[bestSplit].centerBounds;
 
-      if (ctr.raw[dim] < pos) {
-        tmp_primID[l++] = primID[i];
-        lBounds.extend(primBounds[primID[i]]);
+        mid = begin + leftBins.count;
+
+        auto isLeft = [&](int64 id) {
+          return mapping(primCenter(primBounds[id])) < bestSplit;
+        };
+
+        if (numPrims < parallelBlockSize) {
+          std::partition(primID.begin() + begin, primID.begin() + end, isLeft);
+        } else {
+          // stable partition through tmp_primID: each block scatters its
+          // primitives behind those of the preceding blocks
+          std::vector<size_t> blockLeft(
+              (numPrims + parallelBlockSize - 1) / parallelBlockSize + 1);
+
+          const size_t numPartitionBlocks = forEachBlock(
+              begin, end, [&](size_t blockBegin, size_t blockEnd, size_t b) {
+                blockLeft[b] = std::count_if(primID.begin() + blockBegin,
+                                             primID.begin() + blockEnd,
+                                             isLeft);
+              });
+
+          size_t leftOffset = begin;
+          for (size_t b = 0; b < numPartitionBlocks; b++) {
+            const size_t count = blockLeft[b];
+            blockLeft[b]       = leftOffset;
+            leftOffset += count;
+          }
+
+          forEachBlock(
+              begin, end, [&](size_t blockBegin, size_t blockEnd, size_t b) {
+                size_t l = blockLeft[b];
+                size_t r = mid + (blockBegin - begin) - (l - begin);
+                for (size_t i = blockBegin; i < blockEnd; i++) {
+                  if (isLeft(primID[i]))
+                    tmp_primID[l++] = primID[i];
+                  else
+                    tmp_primID[r++] = primID[i];
+                }
+              });
+
+          forEachBlock(
+              begin, end, [&](size_t blockBegin, size_t blockEnd, size_t) {
+                std::copy(&tmp_primID[blockBegin],
+                          &tmp_primID[blockEnd],
+                          primID.begin() + blockBegin);
+              });
+        }
+      }
+    }
+
+    if (!leaf && mid == begin) {
+      if (numPrims <= maxLeafPrims) {
+        leaf = true;
       } else {
-        tmp_primID[--r] = primID[i];
-        rBounds.extend(primBounds[primID[i]]);
+        // median split along the widest axis of the primitive centers, which
+        // bounds the depth of the subtree
+        mid = begin + numPrims / 2;
+
+        std::nth_element(primID.begin() + begin,
+                         primID.begin() + mid,
+                         primID.begin() + end,
+                         [&](int64 a, int64 b) {
+                           return primCenter(primBounds[a])[dim] <
+                                  primCenter(primBounds[b])[dim];
+                         });
+
+        lBounds = computeRangeBounds(primBounds, begin, mid);
+        rBounds = computeRangeBounds(primBounds, mid, end);
       }
     }
 
-    for (size_t i = begin; i < end; i++) {
-      primID[i] = tmp_primID[i];
+    if (leaf) {
+      node[nodeID].childRef = numPrims + begin * sizeof(primID[0]);
+      return;
     }
 
-    float costIfSplit =
-        1 + (1.f / safeArea(bounds4)) * (safeArea(lBounds) * (l - begin) +
+    // child pairs are allocated from the preallocated node storage
+    const size_t childID  = numNodes.fetch_add(2);
+    node[nodeID].childRef = childID * sizeof(Node);
 
-                                         safeArea(rBounds) * (end - l));
+    auto buildChild = [&](int child) {
+      if (child == 0)
+        buildRec(childID + 0,
+                 primBounds,
+                 tmp_primID,
+                 begin,
+                 mid,
+                 lBounds,
+                 depth + 1,
+                 numNodes);
+      else
+        buildRec(childID + 1,
+                 primBounds,
+                 tmp_primID,
+                 mid,
+                 end,
+                 rBounds,
+                 depth + 1,
+                 numNodes);
+    };
 
-    if (
-#ifdef LEAF_THRESHOLD
-        (end - begin) <= LEAF_THRESHOLD ||
-#endif
-        ((costIfSplit >= costNoSplit) && ((end - begin) <= 7)) ||
-        (l == begin) || (l == end)) {
-      node[nodeID].childRef = (end - begin) + begin * sizeof(primID[0]);
+    if (numPrims >= parallelTaskThreshold) {
+      tasking::parallel_for(2, buildChild);
     } else {
-      assert(l > begin);
-      assert(l < end);
-      for (size_t i = begin; i < l; i++) {
-        ctr.as_vec4f = center(primBounds[primID[i]]);
-        assert(ctr.raw[dim] < pos);
+      buildChild(0);
+      buildChild(1);
+    }
+  }
+
+  void MinMaxBVH2::collapseRec(const size_t wideNodeID,
+                               std::array<size_t, wideWidth> children,
+                               int numChildren)
+  {
+    // inner children are replaced by their own children, largest first, until
+    // the wide node is full
+    while (numChildren < wideWidth) {
+      int expand    = -1;
+      float maxArea = 0.f;
+
+      for (int c = 0; c < numChildren; c++) {
+        const Node &child = node[children[c]];
+
+        if ((child.childRef & 0x7) == 0 && safeArea(child) >= maxArea) {
+          expand  = c;
+          maxArea = safeArea(child);
+        }
       }
-      for (size_t i = l; i < end; i++) {
-        ctr.as_vec4f = center(primBounds[primID[i]]);
-        assert(ctr.raw[dim] >= pos);
+
+      if (expand < 0)
+        break;
+
+      const size_t grandChildID =
+          node[children[expand]].childRef / sizeof(Node);
+
+      children[expand]        = grandChildID + 0;
+      children[numChildren++] = grandChildID + 1;
+    }
+
+    WideNode &wide = wideNode.get()[wideNodeID];
+
+    for (int c = 0; c < wideWidth; c++) {
+      if (c >= numChildren) {
+        for (int dim = 0; dim < 3; dim++) {
+          wide.lower[dim][c] = inf;
+          wide.upper[dim][c] = -inf;
+        }
+        wide.childRef[c] = 0;
+        continue;
+      }
+
+      const Node &child = node[children[c]];
+
+      wide.lower[0][c] = child.lower.x;
+      wide.lower[1][c] = child.lower.y;
+      wide.lower[2][c] = child.lower.z;
+      wide.upper[0][c] = child.upper.x;
+      wide.upper[1][c] = child.upper.y;
+      wide.upper[2][c] = child.upper.z;
+
+      if (child.childRef & 0x7) {
+        wide.childRef[c] = child.childRef;
+      } else {
+        const size_t childWideNodeID = numWideNodes++;
+        wide.childRef[c]             = childWideNodeID * sizeof(WideNode);
+
+        const size_t grandChildID = child.childRef / sizeof(Node);
+        collapseRec(childWideNodeID, {{grandChildID, grandChildID + 1}}, 2);
       }
-      size_t childID        = node.size();
-      node[nodeID].childRef = childID * sizeof(Node);
-      node.push_back(Node());
-      node.push_back(Node());
-      buildRec(childID + 0, primBounds, tmp_primID, begin, l);
-      buildRec(childID + 1, primBounds, tmp_primID, l, end);
     }
   }
 
@@ -130,17 +438,42 @@ namespace openvkl {
     this->primID.resize(numPrims);
     std::copy(primRefs, primRefs + numPrims, primID.begin());
 
+    // a binary tree over numPrims leaves has at most numPrims - 1 inner nodes,
+    // each referring to a pair of children; node[1] is unused
     this->node.clear();
-    this->node.push_back(Node());
-    this->node.push_back(Node());
+    this->node.resize(std::max(size_t(2), 2 * numPrims));
+
+    std::atomic<size_t> numNodes(2);
 
     /*! tmp primid array, for non-inplace partition */
     std::vector<int64> tmp_primID(numPrims);
 
-    buildRec(0, primBounds, tmp_primID.data(), 0, numPrims);
-    this->node.resize(this->node.size());
+    buildRec(0,
+             primBounds,
+             tmp_primID.data(),
+             0,
+             numPrims,
+             computeRangeBounds(primBounds, 0, numPrims),
+             0,
+             numNodes);
+
+    this->node.resize(numNodes);
+    this->node.shrink_to_fit();
 
     root = node[0].childRef;
+
+    // each wide node replaces at least one inner binary node, and the root
+    // wide node may hold a single leaf
+    const size_t maxWideNodes = std::max(size_t(1), node.size() / 2);
+
+    wideNode = std::unique_ptr<WideNode, void (*)(void *)>(
+        (WideNode *)ospcommon::memory::alignedMalloc(maxWideNodes *
+                                                     sizeof(WideNode)),
+        ospcommon::memory::alignedFree);
+
+    // the root wide node starts from the binary root, if any primitives
+    numWideNodes = 1;
+    collapseRec(0, {{0}}, numPrims ? 1 : 0);
   }
 
   const void *MinMaxBVH2::nodePtr() const
@@ -149,6 +482,12 @@ namespace openvkl {
     return node.data();
   }
 
+  const void *MinMaxBVH2::wideNodePtr() const
+  {
+    assert(wideNode);
+    return wideNode.get();
+  }
+
   const int64 *MinMaxBVH2::itemListPtr() const
   {
     assert(!primID.empty());
@@ -159,4 +498,45 @@ namespace openvkl {
   {
     return root;
   }
+
+  MinMaxBVH2::Stats MinMaxBVH2::stats() const
+  {
+    Stats stats;
+
+    if (primID.empty())
+      return stats;
+
+    stats.numWideNodes = numWideNodes;
+
+    const float rcpRootArea = 1.f / safeArea(node[0]);
+
+    // (node index, depth) pairs
+    std::vector<std::pair<size_t, int>> stack{{0, 0}};
+
+    while (!stack.empty()) {
+      const size_t nodeID = stack.back().first;
+      const int depth     = stack.back().second;
+      stack.pop_back();
+
+      const Node &n      = node[nodeID];
+      const float area   = safeArea(n) * rcpRootArea;
+      const size_t prims = n.childRef & 0x7;
+
+      stats.numNodes++;
+      stats.maxDepth = std::max(stats.maxDepth, depth);
+
+      if (prims) {
+        stats.numLeaves++;
+        stats.sahCost += area * prims;
+      } else {
+        stats.sahCost += area;
+
+        const size_t childID = n.childRef / sizeof(Node);
+        stack.push_back({childID + 0, depth + 1});
+        stack.push_back({childID + 1, depth + 1});
+      }
+    }
+
+    return stats;
+  }
 }  // namespace openvkl
@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
 // ospray
 #include "../common/Data.h"
 #include "../common/math.h"
@@ -34,6 +37,23 @@ namespace openvkl {
       uint64 childRef;
     };
 
+    /*! number of children of the nodes of the wide BVH; must match
+        MINMAXBVH_WIDE_WIDTH in MinMaxBVH2.ih */
+    static constexpr int wideWidth = 4;
+
+    /*! a node of the wide BVH collapsed from the binary BVH for point
+        location: the spatial bounds of all children in SoA layout, such that
+        one node fills a pair of cache lines. leaf references are those of the
+        binary BVH; inner references are byte offsets of wide nodes. unused
+        children have empty bounds. */
+    struct WideNode
+    {
+      float lower[3][wideWidth];
+      float upper[3][wideWidth];
+      uint64 childRef[wideWidth];
+    };
+
+    /*! builds the BVH with a task-parallel binned SAH builder */
     void build(/*! one bounding box per primitive. The attribute value
                             is in the 'w' component */
                const box4f *const primBounds,
@@ -48,16 +68,51 @@ namespace openvkl {
 
     const void *nodePtr() const;
 
+    /*! wide BVH, rooted at the first node */
+    const void *wideNodePtr() const;
+
     const int64 *itemListPtr() const;
 
     uint64 rootRef() const;
 
+    /*! statistics of the last build, for diagnostics */
+    struct Stats
+    {
+      size_t numNodes{0};
+      size_t numLeaves{0};
+      size_t numWideNodes{0};
+      int maxDepth{0};
+      /*! SAH cost of the tree, with unit node traversal and primitive
+          intersection costs */
+      float sahCost{0.f};
+    };
+
+    Stats stats() const;
+
    private:
+    /*! bounds of a primitive range, and of its primitive centers */
+    struct RangeBounds
+    {
+      box4f bounds{empty};
+      box3f centerBounds{empty};
+    };
+
     void buildRec(const size_t nodeID,
                   const box4f *const primBounds,
                   int64 *tmp_primID,
                   const size_t begin,
-                  const size_t end);
+                  const size_t end,
+                  const RangeBounds &rangeBounds,
+                  const int depth,
+                  std::atomic<size_t> &numNodes);
+
+    void collapseRec(const size_t wideNodeID,
+                     std::array<size_t, wideWidth> children,
+                     int numChildren);
+
+    RangeBounds computeRangeBounds(const box4f *const primBounds,
+                                   const size_t begin,
+                                   const size_t end) const;
 
     const box4f &bounds() const;
 
@@ -68,6 +123,9 @@ namespace openvkl {
     /*! item list. The builder allocates this array, and fills it with
       ints that refer to the primitives; it's up to the */
     std::vector<int64> primID;
+    /*! wide nodes, in cache line aligned storage */
+    std::unique_ptr<WideNode, void (*)(void *)> wideNode{nullptr, nullptr};
+    size_t numWideNodes{0};
     /*! node reference to the root node */
     uint64 root;
   };
@@ -0,0 +1,133 @@
+// ======================================================================== //
+// Copyright 2019 Intel Corporation                                         //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "StructuredRectilinearVolume.h"
+#include <algorithm>
+#include <limits>
+#include <string>
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    template <int W>
+    ispc::SharedStructuredVolumeGridType
+    StructuredRectilinearVolume<W>::prepareGrid()
+    {
+      const vec3i &dimensions = this->dimensions;
+
+      prepareAxis(0, "xCoordinates", dimensions.x);
+      prepareAxis(1, "yCoordinates", dimensions.y);
+      prepareAxis(2, "zCoordinates", dimensions.z);
+
+      // the grid origin is the first vertex, and the grid spacing is the
+      // smallest cell size along each axis; the latter determines nominal
+      // step sizes for iteration and gradient computation.
+      float origin[3];
+      float minCellSize[3];
+
+      for (int axis = 0; axis < 3; axis++) {
+        const std::vector<float> &c = coordinates[axis];
+
+        origin[axis]      = c.front();
+        minCellSize[axis] = std::numeric_limits<float>::infinity();
+
+        for (size_t i = 0; i + 1 < c.size(); i++)
+          minCellSize[axis] = std::min(minCellSize[axis], c[i + 1] - c[i]);
+      }
+
+      this->gridOrigin  = vec3f(origin[0], origin[1], origin[2]);
+      this->gridSpacing = vec3f(minCellSize[0], minCellSize[1], minCellSize[2]);
+
+      return ispc::structured_rectilinear;
+    }
+
+    template <int W>
+    void StructuredRectilinearVolume<W>::prepareAxis(int axis,
+                                                     const char *parameterName,
+                                                     int numVertices)
+    {
+      const Data *data =
+          (Data *)this->template getParam<ManagedObject::VKL_PTR>(
+              parameterName, nullptr);
+
+      if (!data) {
+        throw std::runtime_error(std::string("no ") + parameterName +
+                                 " set on StructuredRectilinearVolume");
+      }
+
+      if (data->size() != size_t(numVertices)) {
+        throw std::runtime_error(
+            std::string(parameterName) +
+            " size does not match the volume dimensions");
+      }
+
+      if (numVertices < 2) {
+        throw std::runtime_error(
+            "StructuredRectilinearVolume requires at least two vertices per "
+            "dimension");
+      }
+
+      std::vector<float> &c = coordinates[axis];
+
+      if (data->dataType == VKL_FLOAT) {
+        c.assign(data->begin<float>(), data->end<float>());
+      } else if (data->dataType == VKL_DOUBLE) {
+        c.assign(data->begin<double>(), data->end<double>());
+      } else {
+        throw std::runtime_error(std::string(parameterName) +
+                                 " must be of type VKL_FLOAT or VKL_DOUBLE");
+      }
+
+      for (size_t i = 0; i + 1 < c.size(); i++) {
+        if (!(c[i] < c[i + 1])) {
+          throw std::runtime_error(std::string(parameterName) +
+                                   " must be strictly increasing");
+        }
+      }
+
+      // one bin per cell on average; lookup[b] is the cell containing the
+      // lower bound of bin b, and the trailing entry is the last cell. cells
+      // overlapping bin b are thus lookup[b] ... lookup[b + 1].
+      const size_t numCells = c.size() - 1;
+      const uint32_t numBins = numCells;
+      const float scale      = numBins / (c.back() - c.front());
+
+      std::vector<uint32_t> &table = lookup[axis];
+      table.resize(numBins + 1);
+
+      size_t cell = 0;
+      for (uint32_t b = 0; b <= numBins; b++) {
+        const float binLower = c.front() + b / scale;
+
+        while (cell + 1 < numCells && c[cell + 1] <= binLower)
+          cell++;
+
+        table[b] = cell;
+      }
+
+      ispc::SharedStructuredVolume_setRectilinearAxis(
+          this->ispcEquivalent, axis, c.data(), table.data(), numBins, scale);
+    }
+
+    VKL_REGISTER_VOLUME(StructuredRectilinearVolume<4>,
+                        structured_rectilinear_4)
+    VKL_REGISTER_VOLUME(StructuredRectilinearVolume<8>,
+                        structured_rectilinear_8)
+    VKL_REGISTER_VOLUME(StructuredRectilinearVolume<16>,
+                        structured_rectilinear_16)
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
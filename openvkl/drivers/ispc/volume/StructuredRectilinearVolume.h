@@ -0,0 +1,45 @@
+// ======================================================================== //
+// Copyright 2019 Intel Corporation                                         //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include <vector>
+#include "StructuredRegularVolume.h"
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    // structured volume with non-uniform vertex coordinates along each axis,
+    // given by the xCoordinates, yCoordinates and zCoordinates parameters.
+    // sampling, layouts, filters and iteration are shared with
+    // StructuredRegularVolume; only the grid transformations differ.
+    template <int W>
+    struct StructuredRectilinearVolume : public StructuredRegularVolume<W>
+    {
+     protected:
+      ispc::SharedStructuredVolumeGridType prepareGrid() override;
+
+      void prepareAxis(int axis, const char *parameterName, int numVertices);
+
+      // vertex coordinates per axis, converted to float
+      std::vector<float> coordinates[3];
+
+      // per-axis lookup tables from uniformly sized bins to cell indices
+      std::vector<uint32_t> lookup[3];
+    };
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
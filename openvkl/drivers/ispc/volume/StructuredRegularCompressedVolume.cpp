@@ -0,0 +1,214 @@
+// ======================================================================== //
+// Copyright 2019 Intel Corporation                                         //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "StructuredRegularCompressedVolume.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "ospcommon/tasking/parallel_for.h"
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    template <int W>
+    const void *StructuredRegularCompressedVolume<W>::prepareVoxelData(
+        ispc::SharedStructuredVolumeLayout &layout, VKLDataType &voxelType)
+    {
+      const int bitsPerVoxel = this->template getParam<int>("bitsPerVoxel", 8);
+
+      if (this->attributesData.size() > 1) {
+        throw std::runtime_error(
+            "StructuredRegularCompressedVolume supports a single attribute");
+      }
+
+      if (bitsPerVoxel != 8 && bitsPerVoxel != 16) {
+        throw std::runtime_error(
+            "bitsPerVoxel must be 8 or 16 for "
+            "StructuredRegularCompressedVolume");
+      }
+
+      voxelType = bitsPerVoxel == 8 ? VKL_UCHAR : VKL_USHORT;
+
+      layout = ispc::voxel_layout_compressed;
+
+      if (this->voxelData) {
+        // only the bricks overlapping the region marked by updateRegion() are
+        // recompressed if the codes are otherwise unchanged
+        const bool dirtyBricksOnly =
+            this->updatesDirtyRegionOnly(layout, voxelType);
+
+        if (bitsPerVoxel == 8) {
+          compressVoxelData<unsigned char>(dirtyBricksOnly);
+        } else {
+          compressVoxelData<unsigned short>(dirtyBricksOnly);
+        }
+
+        compressedDimensions   = this->dimensions;
+        compressedBitsPerVoxel = bitsPerVoxel;
+
+        // the full precision source is not referenced once compressed, so
+        // that the application can release it; later commits reuse the
+        // compressed bricks until voxelData is set again
+        this->setParam("voxelData", ManagedObject::VKL_PTR(nullptr));
+        this->voxelData = nullptr;
+        this->attributesData.assign(1, nullptr);
+      } else if (this->dimensions != compressedDimensions ||
+                 bitsPerVoxel != compressedBitsPerVoxel) {
+        throw std::runtime_error(
+            "voxelData must be set again to change dimensions or "
+            "bitsPerVoxel of StructuredRegularCompressedVolume");
+      }
+
+      ispc::SharedStructuredVolume_setCompressedBrickRanges(
+          this->ispcEquivalent, brickDecodeRanges.data());
+
+      return this->brickedVoxelData.data();
+    }
+
+    template <int W>
+    template <typename CODE_TYPE>
+    void StructuredRegularCompressedVolume<W>::compressVoxelData(
+        bool dirtyBricksOnly)
+    {
+      switch (this->voxelData->dataType) {
+      case VKL_UCHAR:
+        compressBricks<unsigned char, CODE_TYPE>(dirtyBricksOnly);
+        break;
+      case VKL_SHORT:
+        compressBricks<short, CODE_TYPE>(dirtyBricksOnly);
+        break;
+      case VKL_USHORT:
+        compressBricks<unsigned short, CODE_TYPE>(dirtyBricksOnly);
+        break;
+      case VKL_FLOAT:
+        compressBricks<float, CODE_TYPE>(dirtyBricksOnly);
+        break;
+      case VKL_DOUBLE:
+        compressBricks<double, CODE_TYPE>(dirtyBricksOnly);
+        break;
+      default:
+        throw std::runtime_error(
+            "unsupported voxelData type '" +
+            stringForType(this->voxelData->dataType) +
+            "' for StructuredRegularCompressedVolume");
+      }
+    }
+
+    template <int W>
+    template <typename VOXEL_TYPE, typename CODE_TYPE>
+    void StructuredRegularCompressedVolume<W>::compressBricks(
+        bool dirtyBricksOnly)
+    {
+      // must match SSV_BRICK_WIDTH_BITCOUNT in SharedStructuredVolume.ih
+      const int brickWidthBitCount = 3;
+      const int brickWidth         = 1 << brickWidthBitCount;
+      const int voxelsPerBrick     = brickWidth * brickWidth * brickWidth;
+
+      const float maxCode = float(std::numeric_limits<CODE_TYPE>::max());
+
+      const vec3i &dimensions = this->dimensions;
+
+      const size_t numBricks = this->getBrickCount();
+
+      // codes in the padding of partial bricks are never sampled, but are
+      // zero-initialized here
+      if (!dirtyBricksOnly || brickDecodeRanges.size() != numBricks) {
+        this->brickedVoxelData.assign(
+            numBricks * voxelsPerBrick * sizeof(CODE_TYPE), 0);
+        brickDecodeRanges.resize(numBricks);
+        dirtyBricksOnly = false;
+      }
+
+      const VOXEL_TYPE *source =
+          static_cast<const VOXEL_TYPE *>(this->voxelData->data);
+
+      CODE_TYPE *codes =
+          reinterpret_cast<CODE_TYPE *>(this->brickedVoxelData.data());
+
+      this->forEachBrick(dirtyBricksOnly, [&](size_t brickIndex,
+                                              const vec3i &lower,
+                                              const vec3i &upper) {
+        auto sourceValue = [&](int x, int y, int z) {
+          return float(source[size_t(z) * dimensions.y * dimensions.x +
+                              size_t(y) * dimensions.x + x]);
+        };
+
+        // non-finite voxels are excluded from the value range, and decode to
+        // its minimum
+        float lo = std::numeric_limits<float>::infinity();
+        float hi = -std::numeric_limits<float>::infinity();
+
+        for (int z = lower.z; z < upper.z; z++) {
+          for (int y = lower.y; y < upper.y; y++) {
+            for (int x = lower.x; x < upper.x; x++) {
+              const float v = sourceValue(x, y, z);
+              if (std::isfinite(v)) {
+                lo = std::min(lo, v);
+                hi = std::max(hi, v);
+              }
+            }
+          }
+        }
+
+        if (lo > hi) {
+          lo = hi = 0.f;
+        }
+
+        const float scale = (hi - lo) / maxCode;
+
+        brickDecodeRanges[brickIndex] = vec2f(lo, scale);
+
+        CODE_TYPE *brickCodes = codes + brickIndex * voxelsPerBrick;
+
+        // codes of recompressed bricks are those of the previous commit
+        if (dirtyBricksOnly) {
+          std::fill(brickCodes, brickCodes + voxelsPerBrick, CODE_TYPE(0));
+        }
+
+        if (scale == 0.f) {
+          return;
+        }
+
+        for (int z = lower.z; z < upper.z; z++) {
+          for (int y = lower.y; y < upper.y; y++) {
+            for (int x = lower.x; x < upper.x; x++) {
+              const float v = sourceValue(x, y, z);
+
+              if (!std::isfinite(v)) {
+                continue;
+              }
+
+              const float code = std::round((v - lo) / scale);
+
+              brickCodes[((z - lower.z) * brickWidth + (y - lower.y)) *
+                             brickWidth +
+                         (x - lower.x)] =
+                  CODE_TYPE(std::min(std::max(code, 0.f), maxCode));
+            }
+          }
+        }
+      });
+    }
+
+    VKL_REGISTER_VOLUME(StructuredRegularCompressedVolume<4>,
+                        structured_regular_compressed_4)
+    VKL_REGISTER_VOLUME(StructuredRegularCompressedVolume<8>,
+                        structured_regular_compressed_8)
+    VKL_REGISTER_VOLUME(StructuredRegularCompressedVolume<16>,
+                        structured_regular_compressed_16)
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
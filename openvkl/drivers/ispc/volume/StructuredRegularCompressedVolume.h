@@ -0,0 +1,64 @@
+// ======================================================================== //
+// Copyright 2019 Intel Corporation                                         //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include <vector>
+#include "StructuredRegularVolume.h"
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    // structured regular volume stored in 8^3 voxel bricks, with voxel values
+    // quantized to 8 or 16 bits relative to the value range of each brick.
+    // voxels are decoded on the fly during sampling and iteration. the
+    // full precision voxelData is released once compressed.
+    template <int W>
+    struct StructuredRegularCompressedVolume : public StructuredRegularVolume<W>
+    {
+     protected:
+      const void *prepareVoxelData(ispc::SharedStructuredVolumeLayout &layout,
+                                   VKLDataType &voxelType) override;
+
+      bool hasPreparedVoxelData() const override;
+
+      // compresses voxelData; existing bricks outside of dirtyRegion are kept
+      // if dirtyBricksOnly is set
+      template <typename CODE_TYPE>
+      void compressVoxelData(bool dirtyBricksOnly);
+
+      template <typename VOXEL_TYPE, typename CODE_TYPE>
+      void compressBricks(bool dirtyBricksOnly);
+
+      // (minimum, scale) decode range of each brick
+      std::vector<vec2f> brickDecodeRanges;
+
+      // configuration the current bricks were compressed with
+      vec3i compressedDimensions{0};
+      int compressedBitsPerVoxel{0};
+    };
+
+    // Inlined definitions ////////////////////////////////////////////////////
+
+    template <int W>
+    inline bool StructuredRegularCompressedVolume<W>::hasPreparedVoxelData()
+        const
+    {
+      return !brickDecodeRanges.empty();
+    }
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
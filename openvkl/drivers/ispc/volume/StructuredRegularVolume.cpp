@@ -15,6 +15,10 @@
 // ======================================================================== //
 
 #include "StructuredRegularVolume.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include "../common/logging.h"
 #include "GridAccelerator_ispc.h"
 #include "ospcommon/tasking/parallel_for.h"
 
@@ -37,13 +41,42 @@ namespace openvkl {
       voxelData = (Data *)this->template getParam<ManagedObject::VKL_PTR>(
           "voxelData", nullptr);
 
+      // voxelData is either a single attribute, or a data array of attributes
+      // which share the volume's grid
+      attributesData.clear();
+
       if (!voxelData) {
-        throw std::runtime_error("no voxelData set on volume");
+        if (!hasPreparedVoxelData()) {
+          throw std::runtime_error("no voxelData set on volume");
+        }
+
+        // a single attribute, whose source was released after a previous
+        // commit
+        attributesData.push_back(nullptr);
+      } else if (voxelData->dataType == VKL_DATA) {
+        Data **attributes = static_cast<Data **>(voxelData->data);
+        attributesData.assign(attributes, attributes + voxelData->size());
+
+        if (attributesData.empty()) {
+          throw std::runtime_error("no attributes in voxelData");
+        }
+
+        for (const Data *attribute : attributesData) {
+          if (!attribute) {
+            throw std::runtime_error("null attribute in voxelData");
+          }
+        }
+
+        voxelData = attributesData[0];
+      } else {
+        attributesData.push_back(voxelData);
       }
 
-      if (voxelData->size() != longProduct(this->dimensions)) {
-        throw std::runtime_error(
-            "incorrect voxelData size for provided volume dimensions");
+      for (const Data *attribute : attributesData) {
+        if (attribute && attribute->size() != longProduct(this->dimensions)) {
+          throw std::runtime_error(
+              "incorrect voxelData size for provided volume dimensions");
+        }
       }
 
       if (!this->ispcEquivalent) {
@@ -55,14 +88,118 @@ namespace openvkl {
         }
       }
 
+      const std::string filterString =
+          this->template getParam<std::string>("filter", "trilinear");
+
+      ispc::SharedStructuredVolumeFilter filter;
+
+      if (filterString == "nearest") {
+        filter = ispc::filter_nearest;
+      } else if (filterString == "trilinear") {
+        filter = ispc::filter_trilinear;
+      } else if (filterString == "tricubic") {
+        filter = ispc::filter_tricubic;
+      } else {
+        throw std::runtime_error("unknown filter '" + filterString +
+                                 "' for StructuredRegularVolume");
+      }
+
+      const std::string hitMethodString =
+          this->template getParam<std::string>("hitMethod", "fixed");
+
+      ispc::SharedStructuredVolumeHitMethod hitMethod;
+
+      if (hitMethodString == "fixed") {
+        hitMethod = ispc::hit_method_fixed;
+      } else if (hitMethodString == "adaptive") {
+        hitMethod = ispc::hit_method_adaptive;
+      } else if (hitMethodString == "exact") {
+        hitMethod = ispc::hit_method_exact;
+      } else {
+        throw std::runtime_error("unknown hitMethod '" + hitMethodString +
+                                 "' for StructuredRegularVolume");
+      }
+
+      const std::string intervalResolutionString =
+          this->template getParam<std::string>("intervalResolution",
+                                               "macrocell");
+
+      ispc::SharedStructuredVolumeIntervalResolution intervalResolution;
+
+      if (intervalResolutionString == "macrocell") {
+        intervalResolution = ispc::interval_resolution_macrocell;
+      } else if (intervalResolutionString == "voxel") {
+        intervalResolution = ispc::interval_resolution_voxel;
+      } else {
+        throw std::runtime_error("unknown intervalResolution '" +
+                                 intervalResolutionString +
+                                 "' for StructuredRegularVolume");
+      }
+
+      // macrocells of the iteration accelerator must have a power of two
+      // width in volume cells
+      const int macrocellSize =
+          this->template getParam<int>("macrocellSize", 16);
+
+      macrocellWidthBitCount = 0;
+
+      while ((1 << macrocellWidthBitCount) < macrocellSize &&
+             macrocellWidthBitCount < 30) {
+        macrocellWidthBitCount++;
+      }
+
+      if (macrocellSize < 1 || (1 << macrocellWidthBitCount) != macrocellSize) {
+        throw std::runtime_error(
+            "macrocellSize must be a positive power of two for "
+            "StructuredRegularVolume");
+      }
+
+      const ispc::SharedStructuredVolumeGridType gridType = prepareGrid();
+
+      // the voxel data and accelerator are only updated for the voxels
+      // marked by updateRegion() if the grid is otherwise unchanged, see
+      // updatesDirtyRegionOnly()
+      dirtyRegionOnly = dirtyRegionSet &&
+                        ispc::SharedStructuredVolume_getAccelerator(
+                            this->ispcEquivalent) != nullptr &&
+                        acceleratorDimensions == this->dimensions &&
+                        acceleratorGridType == gridType;
+
+      ispc::SharedStructuredVolumeLayout layout;
+      VKLDataType layoutVoxelType;
+
+      const void *layoutVoxelData = prepareVoxelData(layout, layoutVoxelType);
+
       bool success = ispc::SharedStructuredVolume_set(
           this->ispcEquivalent,
-          voxelData->data,
-          voxelData->dataType,
+          layoutVoxelData,
+          layoutVoxelType,
           (const ispc::vec3i &)this->dimensions,
-          ispc::structured_regular,
+          gridType,
           (const ispc::vec3f &)this->gridOrigin,
-          (const ispc::vec3f &)this->gridSpacing);
+          (const ispc::vec3f &)this->gridSpacing,
+          layout,
+          filter);
+
+      if (success) {
+        success = ispc::SharedStructuredVolume_setHitMethod(
+            this->ispcEquivalent, hitMethod);
+      }
+
+      if (success) {
+        success = ispc::SharedStructuredVolume_setIntervalResolution(
+            this->ispcEquivalent, intervalResolution);
+      }
+
+      if (success) {
+        prepareAttributes(layout, layoutVoxelData, layoutVoxelType);
+
+        success = ispc::SharedStructuredVolume_setAttributes(
+            this->ispcEquivalent,
+            layoutAttributesData.size(),
+            (void *)layoutAttributesData.data(),
+            layoutAttributesTypes.data());
+      }
 
       if (!success) {
         ispc::SharedStructuredVolume_Destructor(this->ispcEquivalent);
@@ -71,28 +208,253 @@ namespace openvkl {
         throw std::runtime_error("failed to commit StructuredRegularVolume");
       }
 
-      buildAccelerator();
+      // the accelerator is only refit if the voxels changed within the
+      // regions marked by updateRegion(), with the same voxel layout and
+      // macrocell layout
+      const bool refit = updatesDirtyRegionOnly(layout, layoutVoxelType) &&
+                         acceleratorMacrocellWidthBitCount ==
+                             macrocellWidthBitCount &&
+                         acceleratorFilter == filter;
+
+      if (!refit || !refitAccelerator()) {
+        buildAccelerator();
+      }
+
+      acceleratorDimensions             = this->dimensions;
+      acceleratorGridType               = gridType;
+      acceleratorLayout                 = layout;
+      acceleratorVoxelType              = layoutVoxelType;
+      acceleratorMacrocellWidthBitCount = macrocellWidthBitCount;
+      acceleratorFilter                 = filter;
+
+      dirtyRegionSet  = false;
+      dirtyRegionOnly = false;
+    }
+
+    template <int W>
+    const void *StructuredRegularVolume<W>::prepareVoxelData(
+        ispc::SharedStructuredVolumeLayout &layout, VKLDataType &voxelType)
+    {
+      const std::string layoutString =
+          this->template getParam<std::string>("layout", "linear");
+
+      voxelType = voxelData->dataType;
+
+      if (layoutString == "linear") {
+        layout = ispc::voxel_layout_linear;
+        brickedVoxelData.clear();
+        return voxelData->data;
+      } else if (layoutString == "bricked") {
+        layout = ispc::voxel_layout_bricked;
+        buildBrickedVoxelData(
+            voxelData,
+            brickedVoxelData,
+            updatesDirtyRegionOnly(layout, voxelData->dataType));
+        return brickedVoxelData.data();
+      } else {
+        throw std::runtime_error("unknown layout '" + layoutString +
+                                 "' for StructuredRegularVolume");
+      }
+    }
+
+    template <int W>
+    ispc::SharedStructuredVolumeGridType
+    StructuredRegularVolume<W>::prepareGrid()
+    {
+      return ispc::structured_regular;
+    }
+
+    template <int W>
+    void StructuredRegularVolume<W>::prepareAttributes(
+        ispc::SharedStructuredVolumeLayout layout,
+        const void *layoutVoxelData,
+        VKLDataType layoutVoxelType)
+    {
+      const size_t numAttributes = attributesData.size();
+
+      // types of the attributes on the previous commit
+      const std::vector<VKLDataType> previousTypes = layoutAttributesTypes;
+
+      layoutAttributesData.assign(1, layoutVoxelData);
+      layoutAttributesTypes.assign(1, layoutVoxelType);
+
+      brickedAttributesData.resize(numAttributes - 1);
+
+      for (size_t i = 1; i < numAttributes; i++) {
+        std::vector<unsigned char> &bricked = brickedAttributesData[i - 1];
+
+        if (layout == ispc::voxel_layout_bricked) {
+          const bool dirtyBricksOnly =
+              updatesDirtyRegionOnly(layout, layoutVoxelType) &&
+              i < previousTypes.size() &&
+              previousTypes[i] == attributesData[i]->dataType;
+
+          buildBrickedVoxelData(attributesData[i], bricked, dirtyBricksOnly);
+          layoutAttributesData.push_back(bricked.data());
+        } else {
+          bricked.clear();
+          layoutAttributesData.push_back(attributesData[i]->data);
+        }
+
+        layoutAttributesTypes.push_back(attributesData[i]->dataType);
+      }
+    }
+
+    template <int W>
+    void StructuredRegularVolume<W>::buildBrickedVoxelData(
+        const Data *source,
+        std::vector<unsigned char> &bricked,
+        bool dirtyBricksOnly)
+    {
+      // must match SSV_BRICK_WIDTH_BITCOUNT in SharedStructuredVolume.ih
+      const int brickWidthBitCount = 3;
+      const int brickWidth         = 1 << brickWidthBitCount;
+
+      const vec3i &dimensions = this->dimensions;
+
+      const size_t bytesPerVoxel = sizeOf(source->dataType);
+      const size_t bytesPerLine  = bytesPerVoxel * dimensions.x;
+      const size_t bytesPerSlice = bytesPerLine * dimensions.y;
+      const size_t bytesPerBrick =
+          bytesPerVoxel * brickWidth * brickWidth * brickWidth;
+
+      const size_t numBytes = getBrickCount() * bytesPerBrick;
+
+      // voxels in the padding of partial bricks are never sampled, but are
+      // zero-initialized here
+      if (!dirtyBricksOnly || bricked.size() != numBytes) {
+        bricked.assign(numBytes, 0);
+        dirtyBricksOnly = false;
+      }
+
+      const unsigned char *sourceData =
+          static_cast<const unsigned char *>(source->data);
+
+      forEachBrick(
+          dirtyBricksOnly,
+          [&](size_t brickIndex, const vec3i &lower, const vec3i &upper) {
+            const size_t bytesPerBrickLine =
+                bytesPerVoxel * (upper.x - lower.x);
+
+            unsigned char *brickData =
+                bricked.data() + brickIndex * bytesPerBrick;
+
+            for (int z = lower.z; z < upper.z; z++) {
+              for (int y = lower.y; y < upper.y; y++) {
+                const size_t brickOffset =
+                    ((z - lower.z) * brickWidth + (y - lower.y)) * brickWidth;
+
+                std::memcpy(brickData + brickOffset * bytesPerVoxel,
+                            sourceData + z * bytesPerSlice + y * bytesPerLine +
+                                lower.x * bytesPerVoxel,
+                            bytesPerBrickLine);
+              }
+            }
+          });
     }
 
     template <int W>
     void StructuredRegularVolume<W>::buildAccelerator()
     {
-      void *accelerator =
-          ispc::SharedStructuredVolume_createAccelerator(this->ispcEquivalent);
-
-      vec3i bricksPerDimension;
-      bricksPerDimension.x =
-          ispc::GridAccelerator_getBricksPerDimension_x(accelerator);
-      bricksPerDimension.y =
-          ispc::GridAccelerator_getBricksPerDimension_y(accelerator);
-      bricksPerDimension.z =
-          ispc::GridAccelerator_getBricksPerDimension_z(accelerator);
-
-      const int numTasks =
-          bricksPerDimension.x * bricksPerDimension.y * bricksPerDimension.z;
-      tasking::parallel_for(numTasks, [&](int taskIndex) {
+      const auto buildStart = std::chrono::steady_clock::now();
+
+      void *accelerator = ispc::SharedStructuredVolume_createAccelerator(
+          this->ispcEquivalent, macrocellWidthBitCount);
+
+      // macrocells are built in rows of one brick width along x, so that each
+      // task reads contiguous voxel rows
+      const int numBuildTasks =
+          ispc::GridAccelerator_getBuildTaskCount(accelerator);
+      tasking::parallel_for(numBuildTasks, [&](int taskIndex) {
         ispc::GridAccelerator_build(accelerator, taskIndex);
       });
+
+      // the value range pyramid is reduced level by level from the macrocells,
+      // with the nodes of each level built in parallel
+      const int numPyramidLevels =
+          ispc::GridAccelerator_getPyramidLevelCount(accelerator);
+
+      for (int level = 0; level < numPyramidLevels; level++) {
+        const int numNodes =
+            ispc::GridAccelerator_getPyramidNodeCount(accelerator, level);
+        tasking::parallel_for(numNodes, [&](int taskIndex) {
+          ispc::GridAccelerator_buildPyramid(accelerator, level, taskIndex);
+        });
+      }
+
+      // macrocell value ranges are stored as 16-bit codes relative to the
+      // global value range where possible, halving their memory footprint
+      if (ispc::GridAccelerator_beginQuantization(accelerator)) {
+        const int numBricks =
+            ispc::GridAccelerator_getPyramidNodeCount(accelerator, 0);
+        tasking::parallel_for(numBricks, [&](int taskIndex) {
+          ispc::GridAccelerator_quantize(accelerator, taskIndex);
+        });
+
+        ispc::GridAccelerator_endQuantization(accelerator);
+      }
+
+      const auto buildEnd = std::chrono::steady_clock::now();
+
+      postLogMessage(VKL_LOG_DEBUG)
+          << "StructuredRegularVolume accelerator build: "
+          << std::chrono::duration<double, std::milli>(buildEnd - buildStart)
+                 .count()
+          << " ms";
+    }
+
+    template <int W>
+    bool StructuredRegularVolume<W>::refitAccelerator()
+    {
+      const auto refitStart = std::chrono::steady_clock::now();
+
+      void *accelerator =
+          ispc::SharedStructuredVolume_getAccelerator(this->ispcEquivalent);
+
+      ispc::GridAccelerator_beginRefit(accelerator,
+                                       (const ispc::vec3i &)dirtyRegion.lower,
+                                       (const ispc::vec3i &)dirtyRegion.upper);
+
+      // the macrocells overlapping the dirty region are rebuilt in rows along
+      // x, as in the full build
+      std::atomic<bool> success(true);
+
+      const int numRefitTasks =
+          ispc::GridAccelerator_getRefitTaskCount(accelerator);
+      tasking::parallel_for(numRefitTasks, [&](int taskIndex) {
+        if (!ispc::GridAccelerator_refit(accelerator, taskIndex))
+          success = false;
+      });
+
+      // new value ranges outside of the quantized global value range
+      if (!success) {
+        postLogMessage(VKL_LOG_DEBUG)
+            << "StructuredRegularVolume accelerator refit: value range "
+               "changed, rebuilding";
+        return false;
+      }
+
+      // only the pyramid nodes above the rebuilt macrocells are updated
+      const int numPyramidLevels =
+          ispc::GridAccelerator_getPyramidLevelCount(accelerator);
+
+      for (int level = 0; level < numPyramidLevels; level++) {
+        const int numNodes =
+            ispc::GridAccelerator_getRefitPyramidNodeCount(accelerator, level);
+        tasking::parallel_for(numNodes, [&](int taskIndex) {
+          ispc::GridAccelerator_refitPyramid(accelerator, level, taskIndex);
+        });
+      }
+
+      const auto refitEnd = std::chrono::steady_clock::now();
+
+      postLogMessage(VKL_LOG_DEBUG)
+          << "StructuredRegularVolume accelerator refit: "
+          << std::chrono::duration<double, std::milli>(refitEnd - refitStart)
+                 .count()
+          << " ms";
+
+      return true;
     }
 
     VKL_REGISTER_VOLUME(StructuredRegularVolume<4>, structured_regular_4)
@@ -16,10 +16,12 @@
 
 #pragma once
 
+#include <vector>
 #include "../common/Data.h"
 #include "../iterator/GridAcceleratorIterator.h"
 #include "SharedStructuredVolume_ispc.h"
 #include "StructuredVolume.h"
+#include "ospcommon/tasking/parallel_for.h"
 
 namespace openvkl {
   namespace ispc_driver {
@@ -56,6 +58,9 @@ namespace openvkl {
                        vVKLHitN<W> &hit,
                        vintn<W> &result) override;
 
+      size_t getIntervalIteratorSize() const override;
+      size_t getHitIteratorSize() const override;
+
       void computeSampleV(const vintn<W> &valid,
                           const vvec3fn<W> &objectCoordinates,
                           vfloatn<W> &samples) const override;
@@ -64,12 +69,115 @@ namespace openvkl {
                             const vvec3fn<W> &objectCoordinates,
                             vvec3fn<W> &gradients) const override;
 
+      void computeSampleAndGradientV(const vintn<W> &valid,
+                                     const vvec3fn<W> &objectCoordinates,
+                                     vfloatn<W> &samples,
+                                     vvec3fn<W> &gradients) const override;
+
+      float computeSampleAndGradient(const vec3f &objectCoordinates,
+                                     vec3f &gradient) const override;
+
+      unsigned int getNumAttributes() const override;
+
+      void computeSampleMV(const vintn<W> &valid,
+                           const vvec3fn<W> &objectCoordinates,
+                           unsigned int M,
+                           const unsigned int *attributeIndices,
+                           float *samples) const override;
+
       box3f getBoundingBox() const override;
 
+      void updateRegion(const box3i &region) override;
+
      protected:
+      // returns the voxel data to be used on the ISPC side, along with its
+      // layout and voxel type; called after the ISPC-side object is created.
+      virtual const void *prepareVoxelData(
+          ispc::SharedStructuredVolumeLayout &layout, VKLDataType &voxelType);
+
+      // returns true if the voxel data prepared on a previous commit can be
+      // used without voxelData set, i.e. prepareVoxelData() accepts a null
+      // voxelData.
+      virtual bool hasPreparedVoxelData() const
+      {
+        return false;
+      }
+
+      // sets up grid type specific data on the ISPC side and returns the grid
+      // type; called after the ISPC-side object is created.
+      virtual ispc::SharedStructuredVolumeGridType prepareGrid();
+
+      // sets up the voxel data of all attributes for the given layout, with
+      // the first attribute as returned by prepareVoxelData().
+      void prepareAttributes(ispc::SharedStructuredVolumeLayout layout,
+                             const void *layoutVoxelData,
+                             VKLDataType layoutVoxelType);
+
+      // returns true if only the voxels in dirtyRegion need to be updated in
+      // voxel data prepared with the given layout and voxel type, as the
+      // remaining configuration is unchanged since the previous commit
+      bool updatesDirtyRegionOnly(ispc::SharedStructuredVolumeLayout layout,
+                                  VKLDataType voxelType) const;
+
+      // number of 8^3 voxel bricks of the volume
+      size_t getBrickCount() const;
+
+      // calls brickFunction(brickIndex, lower, upper) in parallel for the voxel
+      // range [lower, upper) of each brick of the volume, or only the bricks
+      // overlapping dirtyRegion
+      template <typename BRICK_FUNCTION>
+      void forEachBrick(bool dirtyBricksOnly,
+                        const BRICK_FUNCTION &brickFunction) const;
+
+      // reorganizes source into bricks; existing bricks outside of
+      // dirtyRegion are kept if dirtyBricksOnly is set
+      void buildBrickedVoxelData(const Data *source,
+                                 std::vector<unsigned char> &bricked,
+                                 bool dirtyBricksOnly = false);
+
       void buildAccelerator();
 
+      // incrementally updates the accelerator for the voxels in dirtyRegion;
+      // returns false if the accelerator must be rebuilt instead
+      bool refitAccelerator();
+
+      // macrocell width of the iteration accelerator is
+      // 1 << macrocellWidthBitCount volume cells
+      int macrocellWidthBitCount{4};
+
+      // voxels changed since the last commit, see updateRegion()
+      bool dirtyRegionSet{false};
+      box3i dirtyRegion;
+
+      // set during commit if the grid is unchanged since the previous commit,
+      // such that only voxels in dirtyRegion may need to be updated
+      bool dirtyRegionOnly{false};
+
+      // configuration of the current accelerator and voxel data; they can
+      // only be updated for the dirty region while this is unchanged
+      vec3i acceleratorDimensions{0};
+      ispc::SharedStructuredVolumeGridType acceleratorGridType{
+          ispc::structured_regular};
+      ispc::SharedStructuredVolumeLayout acceleratorLayout{
+          ispc::voxel_layout_linear};
+      VKLDataType acceleratorVoxelType{VKL_UNKNOWN};
+      int acceleratorMacrocellWidthBitCount{0};
+      ispc::SharedStructuredVolumeFilter acceleratorFilter{
+          ispc::filter_trilinear};
+
+      // first attribute of the volume, used for iteration
       Data *voxelData{nullptr};
+
+      // all attributes of the volume, starting with voxelData
+      std::vector<Data *> attributesData;
+
+      // voxel data reorganized into bricks, used for the "bricked" layout
+      std::vector<unsigned char> brickedVoxelData;
+      std::vector<std::vector<unsigned char>> brickedAttributesData;
+
+      // per-attribute voxel data and types passed to the ISPC side
+      std::vector<const void *> layoutAttributesData;
+      std::vector<VKLDataType> layoutAttributesTypes;
     };
 
     // Inlined definitions ////////////////////////////////////////////////////
@@ -83,8 +191,15 @@ namespace openvkl {
         const vrange1fn<W> &tRange,
         const ValueSelector<W> *valueSelector)
     {
-      iterator = toVKLIntervalIterator<W>(GridAcceleratorIterator<W>(
-          valid, this, origin, direction, tRange, valueSelector));
+      constructVKLIntervalIterator<GridAcceleratorIntervalIterator<W>>(
+          iterator,
+          (VKLVolume)this,
+          valid,
+          this,
+          origin,
+          direction,
+          tRange,
+          valueSelector);
     }
 
     template <int W>
@@ -94,13 +209,11 @@ namespace openvkl {
         vVKLIntervalN<W> &interval,
         vintn<W> &result)
     {
-      GridAcceleratorIterator<W> *ri =
-          fromVKLIntervalIterator<GridAcceleratorIterator<W>>(&iterator);
-
-      ri->iterateInterval(valid, result);
+      GridAcceleratorIntervalIterator<W> *ri =
+          fromVKLIntervalIterator<GridAcceleratorIntervalIterator<W>>(
+              &iterator);
 
-      interval =
-          *reinterpret_cast<const vVKLIntervalN<W> *>(ri->getCurrentInterval());
+      ri->iterateInterval(valid, interval, result);
     }
 
     template <int W>
@@ -112,8 +225,15 @@ namespace openvkl {
         const vrange1fn<W> &tRange,
         const ValueSelector<W> *valueSelector)
     {
-      iterator = toVKLHitIterator<W>(GridAcceleratorIterator<W>(
-          valid, this, origin, direction, tRange, valueSelector));
+      constructVKLHitIterator<GridAcceleratorHitIterator<W>>(
+          iterator,
+          (VKLVolume)this,
+          valid,
+          this,
+          origin,
+          direction,
+          tRange,
+          valueSelector);
     }
 
     template <int W>
@@ -123,12 +243,22 @@ namespace openvkl {
         vVKLHitN<W> &hit,
         vintn<W> &result)
     {
-      GridAcceleratorIterator<W> *ri =
-          fromVKLHitIterator<GridAcceleratorIterator<W>>(&iterator);
+      GridAcceleratorHitIterator<W> *ri =
+          fromVKLHitIterator<GridAcceleratorHitIterator<W>>(&iterator);
+
+      ri->iterateHit(valid, hit, result);
+    }
 
-      ri->iterateHit(valid, result);
+    template <int W>
+    inline size_t StructuredRegularVolume<W>::getIntervalIteratorSize() const
+    {
+      return sizeof(GridAcceleratorIntervalIterator<W>);
+    }
 
-      hit = *reinterpret_cast<const vVKLHitN<W> *>(ri->getCurrentHit());
+    template <int W>
+    inline size_t StructuredRegularVolume<W>::getHitIteratorSize() const
+    {
+      return sizeof(GridAcceleratorHitIterator<W>);
     }
 
     template <int W>
@@ -155,6 +285,141 @@ namespace openvkl {
                                                    &gradients);
     }
 
+    template <int W>
+    inline void StructuredRegularVolume<W>::computeSampleAndGradientV(
+        const vintn<W> &valid,
+        const vvec3fn<W> &objectCoordinates,
+        vfloatn<W> &samples,
+        vvec3fn<W> &gradients) const
+    {
+      ispc::SharedStructuredVolume_sampleAndGradient_export(
+          (const int *)&valid,
+          this->ispcEquivalent,
+          &objectCoordinates,
+          &samples,
+          &gradients);
+    }
+
+    template <int W>
+    inline float StructuredRegularVolume<W>::computeSampleAndGradient(
+        const vec3f &objectCoordinates, vec3f &gradient) const
+    {
+      return ispc::SharedStructuredVolume_sampleAndGradient_uniform_export(
+          this->ispcEquivalent, &objectCoordinates, &gradient);
+    }
+
+    template <int W>
+    inline unsigned int StructuredRegularVolume<W>::getNumAttributes() const
+    {
+      return attributesData.size();
+    }
+
+    template <int W>
+    inline void StructuredRegularVolume<W>::computeSampleMV(
+        const vintn<W> &valid,
+        const vvec3fn<W> &objectCoordinates,
+        unsigned int M,
+        const unsigned int *attributeIndices,
+        float *samples) const
+    {
+      ispc::SharedStructuredVolume_sampleM_export((const int *)&valid,
+                                                  this->ispcEquivalent,
+                                                  &objectCoordinates,
+                                                  M,
+                                                  attributeIndices,
+                                                  samples);
+    }
+
+    template <int W>
+    inline void StructuredRegularVolume<W>::updateRegion(const box3i &region)
+    {
+      if (dirtyRegionSet) {
+        dirtyRegion = box3i(min(dirtyRegion.lower, region.lower),
+                            max(dirtyRegion.upper, region.upper));
+      } else {
+        dirtyRegion    = region;
+        dirtyRegionSet = true;
+      }
+    }
+
+    template <int W>
+    inline bool StructuredRegularVolume<W>::updatesDirtyRegionOnly(
+        ispc::SharedStructuredVolumeLayout layout, VKLDataType voxelType) const
+    {
+      return dirtyRegionOnly && acceleratorLayout == layout &&
+             acceleratorVoxelType == voxelType;
+    }
+
+    template <int W>
+    inline size_t StructuredRegularVolume<W>::getBrickCount() const
+    {
+      // must match SSV_BRICK_WIDTH_BITCOUNT in SharedStructuredVolume.ih
+      const int brickWidthBitCount = 3;
+      const int brickWidth         = 1 << brickWidthBitCount;
+
+      const vec3i &dimensions = this->dimensions;
+
+      return size_t((dimensions.x + brickWidth - 1) >> brickWidthBitCount) *
+             ((dimensions.y + brickWidth - 1) >> brickWidthBitCount) *
+             ((dimensions.z + brickWidth - 1) >> brickWidthBitCount);
+    }
+
+    template <int W>
+    template <typename BRICK_FUNCTION>
+    inline void StructuredRegularVolume<W>::forEachBrick(
+        bool dirtyBricksOnly, const BRICK_FUNCTION &brickFunction) const
+    {
+      // must match SSV_BRICK_WIDTH_BITCOUNT in SharedStructuredVolume.ih
+      const int brickWidthBitCount = 3;
+      const int brickWidth         = 1 << brickWidthBitCount;
+
+      const vec3i &dimensions = this->dimensions;
+
+      const vec3i bricksPerDimension(
+          (dimensions.x + brickWidth - 1) >> brickWidthBitCount,
+          (dimensions.y + brickWidth - 1) >> brickWidthBitCount,
+          (dimensions.z + brickWidth - 1) >> brickWidthBitCount);
+
+      vec3i brickLower(0);
+      vec3i brickUpper = bricksPerDimension;
+
+      if (dirtyBricksOnly) {
+        const vec3i lower = max(dirtyRegion.lower, vec3i(0));
+        const vec3i upper = max(dirtyRegion.upper, vec3i(0));
+
+        brickLower = min(vec3i(lower.x >> brickWidthBitCount,
+                               lower.y >> brickWidthBitCount,
+                               lower.z >> brickWidthBitCount),
+                         bricksPerDimension);
+        brickUpper =
+            min(vec3i((upper.x + brickWidth - 1) >> brickWidthBitCount,
+                      (upper.y + brickWidth - 1) >> brickWidthBitCount,
+                      (upper.z + brickWidth - 1) >> brickWidthBitCount),
+                bricksPerDimension);
+      }
+
+      const vec3i numBricks = max(brickUpper - brickLower, vec3i(0));
+
+      tasking::parallel_for(
+          size_t(numBricks.x) * numBricks.y * numBricks.z, [&](size_t i) {
+            const vec3i brick =
+                brickLower +
+                vec3i(i % numBricks.x,
+                      (i / numBricks.x) % numBricks.y,
+                      i / (size_t(numBricks.x) * numBricks.y));
+
+            const size_t brickIndex =
+                (size_t(brick.z) * bricksPerDimension.y + brick.y) *
+                    bricksPerDimension.x +
+                brick.x;
+
+            const vec3i lower = brick * brickWidth;
+            const vec3i upper = min(lower + vec3i(brickWidth), dimensions);
+
+            brickFunction(brickIndex, lower, upper);
+          });
+    }
+
     template <int W>
     inline box3f StructuredRegularVolume<W>::getBoundingBox() const
     {
@@ -0,0 +1,63 @@
+// ======================================================================== //
+// Copyright 2019 Intel Corporation                                         //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "StructuredSphericalVolume.h"
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    template <int W>
+    ispc::SharedStructuredVolumeGridType
+    StructuredSphericalVolume<W>::prepareGrid()
+    {
+      const vec3f &gridOrigin  = this->gridOrigin;
+      const vec3f &gridSpacing = this->gridSpacing;
+
+      const vec3f gridUpper =
+          gridOrigin + vec3f(this->dimensions - 1) * gridSpacing;
+
+      if (gridSpacing.x <= 0.f || gridSpacing.y <= 0.f ||
+          gridSpacing.z <= 0.f) {
+        throw std::runtime_error(
+            "StructuredSphericalVolume requires a positive gridSpacing");
+      }
+
+      if (gridOrigin.x < 0.f) {
+        throw std::runtime_error(
+            "StructuredSphericalVolume radius range must be non-negative");
+      }
+
+      if (gridOrigin.y < 0.f || gridUpper.y > 180.f) {
+        throw std::runtime_error(
+            "StructuredSphericalVolume inclination range must be within "
+            "[0, 180] degrees");
+      }
+
+      if (gridOrigin.z < 0.f || gridUpper.z > 360.f) {
+        throw std::runtime_error(
+            "StructuredSphericalVolume azimuth range must be within [0, 360] "
+            "degrees");
+      }
+
+      return ispc::structured_spherical;
+    }
+
+    VKL_REGISTER_VOLUME(StructuredSphericalVolume<4>, structured_spherical_4)
+    VKL_REGISTER_VOLUME(StructuredSphericalVolume<8>, structured_spherical_8)
+    VKL_REGISTER_VOLUME(StructuredSphericalVolume<16>, structured_spherical_16)
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
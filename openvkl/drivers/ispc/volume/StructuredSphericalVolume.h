@@ -0,0 +1,36 @@
+// ======================================================================== //
+// Copyright 2019 Intel Corporation                                         //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "StructuredRegularVolume.h"
+
+namespace openvkl {
+  namespace ispc_driver {
+
+    // structured volume on a spherical grid; dimensions, gridOrigin and
+    // gridSpacing are given in (radius, inclination, azimuth) order, with
+    // angles in degrees. sampling and layouts are shared with
+    // StructuredRegularVolume, while iteration walks macrocells in index space.
+    template <int W>
+    struct StructuredSphericalVolume : public StructuredRegularVolume<W>
+    {
+     protected:
+      ispc::SharedStructuredVolumeGridType prepareGrid() override;
+    };
+
+  }  // namespace ispc_driver
+}  // namespace openvkl
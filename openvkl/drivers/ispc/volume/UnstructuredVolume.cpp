@@ -15,7 +15,9 @@
 // ======================================================================== //
 
 #include "UnstructuredVolume.h"
+#include <chrono>
 #include "../common/Data.h"
+#include "../common/logging.h"
 #include "ospcommon/tasking/parallel_for.h"
 
 // Map cell type to its vertices count
@@ -156,8 +158,47 @@ namespace openvkl {
         }
       }
 
+      auto precomputeNeighbors =
+          this->template getParam<bool>("precomputedNeighbors", false);
+      if (precomputeNeighbors) {
+        // recomputed on every commit, as the cells may have changed
+        calculateFaceNeighbors();
+      } else {
+        if (!faceNeighbors.empty()) {
+          faceNeighbors.clear();
+          faceNeighbors.shrink_to_fit();
+        }
+      }
+
       auto hexIterative = this->template getParam<bool>("hexIterative", false);
 
+      // BVH depth of the nodes returned as intervals by iterators; deeper nodes
+      // give tighter intervals and value ranges, at higher traversal cost
+      auto maxIteratorDepth =
+          this->template getParam<int>("maxIteratorDepth", 6);
+
+      if (maxIteratorDepth < 0) {
+        throw std::runtime_error(
+            "unstructured volume 'maxIteratorDepth' must be non-negative");
+      }
+
+      const std::string bvhTraversalString =
+          this->template getParam<std::string>("bvhTraversal", "auto");
+
+      ispc::UnstructuredVolumeBVHTraversal bvhTraversal;
+
+      if (bvhTraversalString == "auto") {
+        bvhTraversal = ispc::bvh_traversal_auto;
+      } else if (bvhTraversalString == "packet") {
+        bvhTraversal = ispc::bvh_traversal_packet;
+      } else if (bvhTraversalString == "lane") {
+        bvhTraversal = ispc::bvh_traversal_lane;
+      } else {
+        throw std::runtime_error("unknown bvhTraversal '" +
+                                 bvhTraversalString +
+                                 "' for unstructured volume");
+      }
+
       buildBvhAndCalculateBounds();
 
       if (!this->ispcEquivalent) {
@@ -179,8 +220,13 @@ namespace openvkl {
           bvh.rootRef(),
           bvh.nodePtr(),
           bvh.itemListPtr(),
+          bvh.wideNodePtr(),
           faceNormals.empty() ? nullptr : (const ispc::vec3f *)faceNormals.data(),
-          hexIterative);
+          faceNeighbors.empty() ? nullptr : faceNeighbors.data(),
+          hexIterative,
+          (const ispc::vec3f &)nominalCellSize,
+          maxIteratorDepth,
+          bvhTraversal);
     }
 
     template <int W>
@@ -215,20 +261,42 @@ namespace openvkl {
     template <int W>
     void UnstructuredVolume<W>::buildBvhAndCalculateBounds()
     {
+      const auto buildStart = std::chrono::steady_clock::now();
+
       std::vector<int64> primID(nCells);
       std::vector<box4f> primBounds(nCells);
 
-      box4f bounds4 = empty;
+      // cell bounds are computed in parallel blocks, each reducing the bounds
+      // and cell sizes of its cells
+      const uint64_t blockSize = 16384;
+      const uint64_t numBlocks = (nCells + blockSize - 1) / blockSize;
+
+      std::vector<box4f> blockBounds(numBlocks, box4f(empty));
+      std::vector<vec3f> blockCellSizeSum(numBlocks, vec3f(0.f));
+
+      tasking::parallel_for(numBlocks, [&](uint64_t block) {
+        const uint64_t begin = block * blockSize;
+        const uint64_t end   = std::min(nCells, begin + blockSize);
 
-      for (uint64_t i = 0; i < nCells; i++) {
-        primID[i]       = i;
-        auto cellBounds = getCellBBox(i);
-        if (i == 0) {
-          bounds4 = cellBounds;
-        } else {
-          bounds4.extend(cellBounds);
+        for (uint64_t i = begin; i < end; i++) {
+          primID[i]       = i;
+          auto cellBounds = getCellBBox(i);
+          primBounds[i]   = cellBounds;
+
+          blockBounds[block].extend(cellBounds);
+          blockCellSizeSum[block] +=
+              vec3f(cellBounds.upper.x - cellBounds.lower.x,
+                    cellBounds.upper.y - cellBounds.lower.y,
+                    cellBounds.upper.z - cellBounds.lower.z);
         }
-        primBounds[i] = cellBounds;
+      });
+
+      box4f bounds4 = empty;
+      vec3f cellSizeSum{0.f};
+
+      for (uint64_t block = 0; block < numBlocks; block++) {
+        bounds4.extend(blockBounds[block]);
+        cellSizeSum += blockCellSizeSum[block];
       }
 
       bounds.lower = vec3f(bounds4.lower.x, bounds4.lower.y, bounds4.lower.z);
@@ -237,7 +305,23 @@ namespace openvkl {
       valueRange.lower = bounds4.lower.w;
       valueRange.upper = bounds4.upper.w;
 
+      // average cell extent, used for iterator step sizes
+      nominalCellSize = nCells ? cellSizeSum / float(nCells) : vec3f(0.f);
+
       bvh.build(primBounds.data(), primID.data(), nCells);
+
+      const auto buildEnd = std::chrono::steady_clock::now();
+
+      const MinMaxBVH2::Stats stats = bvh.stats();
+
+      postLogMessage(VKL_LOG_DEBUG)
+          << "UnstructuredVolume BVH build: "
+          << std::chrono::duration<double, std::milli>(buildEnd - buildStart)
+                 .count()
+          << " ms, " << nCells << " cells, " << stats.numNodes << " nodes, "
+          << stats.numLeaves << " leaves, " << stats.numWideNodes
+          << " wide nodes, depth " << stats.maxDepth
+          << ", SAH cost " << stats.sahCost;
     }
 
     template <int W>
@@ -302,6 +386,125 @@ namespace openvkl {
       }
     }
 
+    // Find the cell sharing each face, or -1 on the boundary of the mesh.
+    // Faces are listed in the order of the face normals.
+    template <int W>
+    void UnstructuredVolume<W>::calculateFaceNeighbors()
+    {
+      // Vertices of each face, -1 terminated for triangles
+      const int tetrahedronFaces[4][4] = {
+          {2, 0, 1, -1}, {3, 1, 0, -1}, {3, 2, 1, -1}, {2, 3, 0, -1}};
+      const int hexahedronFaces[6][4] = {{0, 1, 2, 3},
+                                         {0, 1, 5, 4},
+                                         {1, 2, 6, 5},
+                                         {2, 3, 7, 6},
+                                         {0, 3, 7, 4},
+                                         {4, 5, 6, 7}};
+      const int wedgeFaces[5][4] = {{0, 1, 2, -1},
+                                    {0, 1, 4, 3},
+                                    {1, 2, 5, 4},
+                                    {0, 2, 5, 3},
+                                    {3, 4, 5, -1}};
+      const int pyramidFaces[5][4] = {{0, 1, 2, 3},
+                                      {0, 1, 4, -1},
+                                      {1, 2, 4, -1},
+                                      {2, 3, 4, -1},
+                                      {0, 3, 4, -1}};
+
+      const uint8_t *typeArray = (const uint8_t *)cellType->data;
+      const uint64_t nVertices = vertexPosition->size();
+
+      // Cells using each vertex, as offsets into a common array
+      std::vector<uint64_t> vertexCellBegin(nVertices + 1, 0);
+
+      for (uint64_t cellId = 0; cellId < nCells; cellId++) {
+        const uint64_t cOffset = getCellOffset(cellId);
+        for (uint32_t i = 0; i < getVerticesCount(typeArray[cellId]); i++)
+          vertexCellBegin[getVertexId(cOffset + i) + 1]++;
+      }
+
+      for (uint64_t v = 0; v < nVertices; v++)
+        vertexCellBegin[v + 1] += vertexCellBegin[v];
+
+      std::vector<uint64_t> vertexCells(vertexCellBegin[nVertices]);
+      std::vector<uint64_t> vertexCellEnd(vertexCellBegin.begin(),
+                                          vertexCellBegin.end() - 1);
+
+      for (uint64_t cellId = 0; cellId < nCells; cellId++) {
+        const uint64_t cOffset = getCellOffset(cellId);
+        for (uint32_t i = 0; i < getVerticesCount(typeArray[cellId]); i++)
+          vertexCells[vertexCellEnd[getVertexId(cOffset + i)]++] = cellId;
+      }
+
+      faceNeighbors.resize(nCells * 6);
+
+      // The neighbor across a face is the other cell using all its vertices
+      tasking::parallel_for(nCells, [&](uint64_t cellId) {
+        const int(*faces)[4] = nullptr;
+        uint32_t facesCount  = 0;
+
+        switch (typeArray[cellId]) {
+        case VKL_TETRAHEDRON:
+          faces      = tetrahedronFaces;
+          facesCount = 4;
+          break;
+        case VKL_HEXAHEDRON:
+          faces      = hexahedronFaces;
+          facesCount = 6;
+          break;
+        case VKL_WEDGE:
+          faces      = wedgeFaces;
+          facesCount = 5;
+          break;
+        case VKL_PYRAMID:
+          faces      = pyramidFaces;
+          facesCount = 5;
+          break;
+        }
+
+        const uint64_t cOffset = getCellOffset(cellId);
+
+        for (uint32_t i = 0; i < 6; i++) {
+          int64_t neighbor = -1;
+
+          if (i < facesCount) {
+            uint64_t faceVertices[4];
+            uint32_t faceVerticesCount = 0;
+            for (uint32_t j = 0; j < 4 && faces[i][j] >= 0; j++)
+              faceVertices[faceVerticesCount++] =
+                  getVertexId(cOffset + faces[i][j]);
+
+            const uint64_t v0 = faceVertices[0];
+            for (uint64_t k = vertexCellBegin[v0];
+                 k < vertexCellBegin[v0 + 1] && neighbor < 0;
+                 k++) {
+              const uint64_t otherId = vertexCells[k];
+              if (otherId == cellId)
+                continue;
+
+              const uint64_t oOffset = getCellOffset(otherId);
+              const uint32_t oCount  = getVerticesCount(typeArray[otherId]);
+
+              uint32_t shared = 0;
+              for (uint32_t j = 0; j < faceVerticesCount; j++) {
+                for (uint32_t o = 0; o < oCount; o++) {
+                  if (getVertexId(oOffset + o) == faceVertices[j]) {
+                    shared++;
+                    break;
+                  }
+                }
+              }
+
+              if (shared == faceVerticesCount)
+                neighbor = otherId;
+            }
+          }
+
+          faceNeighbors[cellId * 6 + i] = neighbor;
+        }
+      });
+    }
+
     VKL_REGISTER_VOLUME(UnstructuredVolume<4>, unstructured_4)
     VKL_REGISTER_VOLUME(UnstructuredVolume<8>, unstructured_8)
     VKL_REGISTER_VOLUME(UnstructuredVolume<16>, unstructured_16)
@@ -18,6 +18,7 @@
 
 #include "../common/Data.h"
 #include "../common/math.h"
+#include "../iterator/UnstructuredIterator.h"
 #include "MinMaxBVH2.h"
 #include "UnstructuredVolume_ispc.h"
 #include "Volume.h"
@@ -32,6 +33,34 @@ namespace openvkl {
 
       void commit() override;
 
+      void initIntervalIteratorV(
+          const vintn<W> &valid,
+          vVKLIntervalIteratorN<W> &iterator,
+          const vvec3fn<W> &origin,
+          const vvec3fn<W> &direction,
+          const vrange1fn<W> &tRange,
+          const ValueSelector<W> *valueSelector) override;
+
+      void iterateIntervalV(const vintn<W> &valid,
+                            vVKLIntervalIteratorN<W> &iterator,
+                            vVKLIntervalN<W> &interval,
+                            vintn<W> &result) override;
+
+      void initHitIteratorV(const vintn<W> &valid,
+                            vVKLHitIteratorN<W> &iterator,
+                            const vvec3fn<W> &origin,
+                            const vvec3fn<W> &direction,
+                            const vrange1fn<W> &tRange,
+                            const ValueSelector<W> *valueSelector) override;
+
+      void iterateHitV(const vintn<W> &valid,
+                       vVKLHitIteratorN<W> &iterator,
+                       vVKLHitN<W> &hit,
+                       vintn<W> &result) override;
+
+      size_t getIntervalIteratorSize() const override;
+      size_t getHitIteratorSize() const override;
+
       void computeSampleV(const vintn<W> &valid,
                           const vvec3fn<W> &objectCoordinates,
                           vfloatn<W> &samples) const override;
@@ -59,11 +88,13 @@ namespace openvkl {
                                 const uint32_t faces[6][3],
                                 const uint32_t facesCount);
       void calculateFaceNormals();
+      void calculateFaceNeighbors();
 
      protected:
       uint64_t nCells{0};
       box3f bounds{empty};
       range1f valueRange{empty};
+      vec3f nominalCellSize{0.f};
 
       Data *vertexPosition{nullptr};
       Data *vertexValue{nullptr};
@@ -79,12 +110,90 @@ namespace openvkl {
       bool indexPrefixed{false};
 
       std::vector<vec3f> faceNormals;
+      std::vector<int64_t> faceNeighbors;
 
       MinMaxBVH2 bvh;
     };
 
     // Inlined definitions ////////////////////////////////////////////////////
 
+    template <int W>
+    inline void UnstructuredVolume<W>::initIntervalIteratorV(
+        const vintn<W> &valid,
+        vVKLIntervalIteratorN<W> &iterator,
+        const vvec3fn<W> &origin,
+        const vvec3fn<W> &direction,
+        const vrange1fn<W> &tRange,
+        const ValueSelector<W> *valueSelector)
+    {
+      constructVKLIntervalIterator<UnstructuredIntervalIterator<W>>(
+          iterator,
+          (VKLVolume)this,
+          valid,
+          this,
+          origin,
+          direction,
+          tRange,
+          valueSelector);
+    }
+
+    template <int W>
+    inline void UnstructuredVolume<W>::iterateIntervalV(
+        const vintn<W> &valid,
+        vVKLIntervalIteratorN<W> &iterator,
+        vVKLIntervalN<W> &interval,
+        vintn<W> &result)
+    {
+      UnstructuredIntervalIterator<W> *ri =
+          fromVKLIntervalIterator<UnstructuredIntervalIterator<W>>(&iterator);
+
+      ri->iterateInterval(valid, interval, result);
+    }
+
+    template <int W>
+    inline void UnstructuredVolume<W>::initHitIteratorV(
+        const vintn<W> &valid,
+        vVKLHitIteratorN<W> &iterator,
+        const vvec3fn<W> &origin,
+        const vvec3fn<W> &direction,
+        const vrange1fn<W> &tRange,
+        const ValueSelector<W> *valueSelector)
+    {
+      constructVKLHitIterator<UnstructuredHitIterator<W>>(iterator,
+                                                          (VKLVolume)this,
+                                                          valid,
+                                                          this,
+                                                          origin,
+                                                          direction,
+                                                          tRange,
+                                                          valueSelector);
+    }
+
+    template <int W>
+    inline void UnstructuredVolume<W>::iterateHitV(
+        const vintn<W> &valid,
+        vVKLHitIteratorN<W> &iterator,
+        vVKLHitN<W> &hit,
+        vintn<W> &result)
+    {
+      UnstructuredHitIterator<W> *ri =
+          fromVKLHitIterator<UnstructuredHitIterator<W>>(&iterator);
+
+      ri->iterateHit(valid, hit, result);
+    }
+
+    template <int W>
+    inline size_t UnstructuredVolume<W>::getIntervalIteratorSize() const
+    {
+      return sizeof(UnstructuredIntervalIterator<W>);
+    }
+
+    template <int W>
+    inline size_t UnstructuredVolume<W>::getHitIteratorSize() const
+    {
+      return sizeof(UnstructuredHitIterator<W>);
+    }
+
     template <int W>
     inline void UnstructuredVolume<W>::computeSampleV(
         const vintn<W> &valid,
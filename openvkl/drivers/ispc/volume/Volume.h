@@ -16,12 +16,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include "../common/ManagedObject.h"
 #include "../common/objectFactory.h"
 #include "../iterator/DefaultIterator.h"
 #include "../value_selector/ValueSelector.h"
+#include "Volume_ispc.h"
 #include "openvkl/openvkl.h"
 #include "ospcommon/math/box.h"
+#include "ospcommon/tasking/parallel_for.h"
 
 #define THROW_NOT_IMPLEMENTED                          \
   throw std::runtime_error(std::string(__FUNCTION__) + \
@@ -89,23 +92,83 @@ namespace openvkl {
                                vVKLHitN<W> &hit,
                                vintn<W> &result);
 
+      // number of leading bytes of the iterator internal state used by the
+      // interval and hit iterators of this volume at the native width. the
+      // iterators are relocatable, so only these bytes (and the volume
+      // handle) need to be retained between calls.
+      virtual size_t getIntervalIteratorSize() const;
+      virtual size_t getHitIteratorSize() const;
+
       virtual ValueSelector<W> *newValueSelector();
 
       virtual void computeSampleV(const vintn<W> &valid,
                                   const vvec3fn<W> &objectCoordinates,
                                   vfloatn<W> &samples) const = 0;
 
+      // sample the volume at a single point. the default implementation uses
+      // the ISPC-side computeSampleUniform() of the volume.
+      virtual float computeSample(const vec3f &objectCoordinates) const;
+
+      // sample the volume at an arbitrary number of points. the default
+      // implementations run the ISPC-side computeSample() of the volume over
+      // the full arrays, split into parallel tasks for large counts.
+      virtual void computeSampleStream(size_t count,
+                                       const vec3f *objectCoordinates,
+                                       float *samples) const;
+
+      virtual void computeSampleStreamSoA(size_t count,
+                                          const float *objectCoordinatesX,
+                                          const float *objectCoordinatesY,
+                                          const float *objectCoordinatesZ,
+                                          float *samples) const;
+
       virtual void computeGradientV(const vintn<W> &valid,
                                     const vvec3fn<W> &objectCoordinates,
                                     vvec3fn<W> &gradients) const;
 
+      // compute samples and gradients at the same locations. the default
+      // implementation simply calls computeSampleV() and computeGradientV();
+      // volumes should override this if they can share work between both.
+      virtual void computeSampleAndGradientV(
+          const vintn<W> &valid,
+          const vvec3fn<W> &objectCoordinates,
+          vfloatn<W> &samples,
+          vvec3fn<W> &gradients) const;
+
+      // compute the sample and gradient at a single point. the default
+      // implementation runs computeSampleAndGradientV() with one active lane.
+      virtual float computeSampleAndGradient(const vec3f &objectCoordinates,
+                                             vec3f &gradient) const;
+
+      // number of attributes that can be sampled with computeSampleMV()
+      virtual unsigned int getNumAttributes() const;
+
+      // sample M attributes (given by attributeIndices) at the same
+      // locations; samples holds M * W values, one vector of W samples per
+      // attribute. the default implementation supports a single attribute via
+      // computeSampleV().
+      virtual void computeSampleMV(const vintn<W> &valid,
+                                   const vvec3fn<W> &objectCoordinates,
+                                   unsigned int M,
+                                   const unsigned int *attributeIndices,
+                                   float *samples) const;
+
       virtual box3f getBoundingBox() const = 0;
 
       virtual range1f getValueRange() const;
 
+      // marks the voxels in region (lower inclusive, upper exclusive) as
+      // changed since the last commit; volumes may use this to update their
+      // acceleration structures incrementally on the next commit. the default
+      // implementation does nothing, as volumes rebuild on every commit.
+      virtual void updateRegion(const box3i &region);
+
       void *getISPCEquivalent() const;
 
      protected:
+      // number of samples processed per task in stream sampling
+      static constexpr size_t streamTaskSize = 4096;
+
       void *ispcEquivalent{nullptr};
     };
 
@@ -126,8 +189,14 @@ namespace openvkl {
         const vrange1fn<W> &tRange,
         const ValueSelector<W> *valueSelector)
     {
-      iterator = toVKLIntervalIterator<W>(DefaultIterator<W>(
-          valid, this, origin, direction, tRange, valueSelector));
+      constructVKLIntervalIterator<DefaultIterator<W>>(iterator,
+                                                       (VKLVolume)this,
+                                                       valid,
+                                                       this,
+                                                       origin,
+                                                       direction,
+                                                       tRange,
+                                                       valueSelector);
     }
 
     template <int W>
@@ -139,10 +208,7 @@ namespace openvkl {
       DefaultIterator<W> *i =
           fromVKLIntervalIterator<DefaultIterator<W>>(&iterator);
 
-      i->iterateInterval(valid, result);
-
-      interval =
-          *reinterpret_cast<const vVKLIntervalN<W> *>(i->getCurrentInterval());
+      i->iterateInterval(valid, interval, result);
     }
 
     template <int W>
@@ -154,8 +220,14 @@ namespace openvkl {
         const vrange1fn<W> &tRange,
         const ValueSelector<W> *valueSelector)
     {
-      iterator = toVKLHitIterator<W>(DefaultIterator<W>(
-          valid, this, origin, direction, tRange, valueSelector));
+      constructVKLHitIterator<DefaultIterator<W>>(iterator,
+                                                  (VKLVolume)this,
+                                                  valid,
+                                                  this,
+                                                  origin,
+                                                  direction,
+                                                  tRange,
+                                                  valueSelector);
     }
 
     template <int W>
@@ -166,9 +238,19 @@ namespace openvkl {
     {
       DefaultIterator<W> *i = fromVKLHitIterator<DefaultIterator<W>>(&iterator);
 
-      i->iterateHit(valid, result);
+      i->iterateHit(valid, hit, result);
+    }
 
-      hit = *reinterpret_cast<const vVKLHitN<W> *>(i->getCurrentHit());
+    template <int W>
+    inline size_t Volume<W>::getIntervalIteratorSize() const
+    {
+      return sizeof(DefaultIterator<W>);
+    }
+
+    template <int W>
+    inline size_t Volume<W>::getHitIteratorSize() const
+    {
+      return sizeof(DefaultIterator<W>);
     }
 
     template <int W>
@@ -177,6 +259,55 @@ namespace openvkl {
       return new ValueSelector<W>(this);
     }
 
+    template <int W>
+    inline float Volume<W>::computeSample(const vec3f &objectCoordinates) const
+    {
+      return ispc::Volume_sample_uniform_export(ispcEquivalent,
+                                                &objectCoordinates);
+    }
+
+    template <int W>
+    inline void Volume<W>::computeSampleStream(size_t count,
+                                               const vec3f *objectCoordinates,
+                                               float *samples) const
+    {
+      const size_t numTasks = (count + streamTaskSize - 1) / streamTaskSize;
+
+      tasking::parallel_for(numTasks, [&](size_t taskIndex) {
+        const size_t begin = taskIndex * streamTaskSize;
+        const size_t end   = std::min(begin + streamTaskSize, count);
+
+        ispc::Volume_sample_stream_export(
+            ispcEquivalent,
+            int(end - begin),
+            (const ispc::vec3f *)(objectCoordinates + begin),
+            samples + begin);
+      });
+    }
+
+    template <int W>
+    inline void Volume<W>::computeSampleStreamSoA(
+        size_t count,
+        const float *objectCoordinatesX,
+        const float *objectCoordinatesY,
+        const float *objectCoordinatesZ,
+        float *samples) const
+    {
+      const size_t numTasks = (count + streamTaskSize - 1) / streamTaskSize;
+
+      tasking::parallel_for(numTasks, [&](size_t taskIndex) {
+        const size_t begin = taskIndex * streamTaskSize;
+        const size_t end   = std::min(begin + streamTaskSize, count);
+
+        ispc::Volume_sample_stream_soa_export(ispcEquivalent,
+                                              int(end - begin),
+                                              objectCoordinatesX + begin,
+                                              objectCoordinatesY + begin,
+                                              objectCoordinatesZ + begin,
+                                              samples + begin);
+      });
+    }
+
     template <int W>
     inline void Volume<W>::computeGradientV(const vintn<W> &valid,
                                             const vvec3fn<W> &objectCoordinates,
@@ -185,12 +316,72 @@ namespace openvkl {
       THROW_NOT_IMPLEMENTED;
     }
 
+    template <int W>
+    inline void Volume<W>::computeSampleAndGradientV(
+        const vintn<W> &valid,
+        const vvec3fn<W> &objectCoordinates,
+        vfloatn<W> &samples,
+        vvec3fn<W> &gradients) const
+    {
+      computeSampleV(valid, objectCoordinates, samples);
+      computeGradientV(valid, objectCoordinates, gradients);
+    }
+
+    template <int W>
+    inline float Volume<W>::computeSampleAndGradient(
+        const vec3f &objectCoordinates, vec3f &gradient) const
+    {
+      vintn<W> validW;
+      vvec3fn<W> ocW;
+
+      for (int i = 0; i < W; i++) {
+        validW[i] = i == 0;
+        ocW.x[i]  = objectCoordinates.x;
+        ocW.y[i]  = objectCoordinates.y;
+        ocW.z[i]  = objectCoordinates.z;
+      }
+
+      vfloatn<W> samplesW;
+      vvec3fn<W> gradientsW;
+
+      computeSampleAndGradientV(validW, ocW, samplesW, gradientsW);
+
+      gradient = vec3f(gradientsW.x[0], gradientsW.y[0], gradientsW.z[0]);
+
+      return samplesW[0];
+    }
+
+    template <int W>
+    inline unsigned int Volume<W>::getNumAttributes() const
+    {
+      return 1;
+    }
+
+    template <int W>
+    inline void Volume<W>::computeSampleMV(const vintn<W> &valid,
+                                           const vvec3fn<W> &objectCoordinates,
+                                           unsigned int M,
+                                           const unsigned int *attributeIndices,
+                                           float *samples) const
+    {
+      for (unsigned int i = 0; i < M; i++) {
+        computeSampleV(valid,
+                       objectCoordinates,
+                       *reinterpret_cast<vfloatn<W> *>(samples + i * W));
+      }
+    }
+
     template <int W>
     inline range1f Volume<W>::getValueRange() const
     {
       THROW_NOT_IMPLEMENTED;
     }
 
+    template <int W>
+    inline void Volume<W>::updateRegion(const box3i &)
+    {
+    }
+
     template <int W>
     inline void *Volume<W>::getISPCEquivalent() const
     {
@@ -73,6 +73,10 @@ typedef enum
   // Unsigned 64-bit integer scalar and vector types.
   VKL_ULONG = 5550, VKL_ULONG2, VKL_ULONG3, VKL_ULONG4,
 
+  // Half precision (IEEE 754 binary16) and bfloat16 floating point scalar
+  // types.
+  VKL_HALF = 5800, VKL_BFLOAT16,
+
   // Single precision floating point scalar and vector types.
   VKL_FLOAT = 6000, VKL_FLOAT2, VKL_FLOAT3, VKL_FLOAT4, VKL_FLOAT3A,
 
@@ -85,6 +85,14 @@ typedef struct
   float nominalDeltaT[16];
 } VKLInterval16;
 
+// returns the number of leading bytes of internalState used by interval
+// iterators of the given volume (for all widths, including scalar). the
+// iterator state is relocatable: applications storing many iterators may
+// retain only these bytes and the volume handle, and copy them back into a
+// full iterator object to continue iteration.
+OPENVKL_INTERFACE
+size_t vklGetIntervalIteratorSize(VKLVolume volume);
+
 OPENVKL_INTERFACE
 void vklInitIntervalIterator(VKLIntervalIterator *iterator,
                              VKLVolume volume,
@@ -198,6 +206,11 @@ typedef struct
   float sample[16];
 } VKLHit16;
 
+// returns the number of leading bytes of internalState used by hit iterators
+// of the given volume; see vklGetIntervalIteratorSize()
+OPENVKL_INTERFACE
+size_t vklGetHitIteratorSize(VKLVolume volume);
+
 OPENVKL_INTERFACE
 void vklInitHitIterator(VKLHitIterator *iterator,
                         VKLVolume volume,
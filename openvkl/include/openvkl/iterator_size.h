@@ -19,13 +19,13 @@
 // see SIMD conformance tests
 
 #define ITERATOR_INTERNAL_STATE_ALIGNMENT 64
-#define ITERATOR_INTERNAL_STATE_SIZE 2048
+#define ITERATOR_INTERNAL_STATE_SIZE 1472
 
 #define ITERATOR_INTERNAL_STATE_ALIGNMENT_4 16
-#define ITERATOR_INTERNAL_STATE_SIZE_4 512
+#define ITERATOR_INTERNAL_STATE_SIZE_4 368
 
 #define ITERATOR_INTERNAL_STATE_ALIGNMENT_8 32
-#define ITERATOR_INTERNAL_STATE_SIZE_8 1024
+#define ITERATOR_INTERNAL_STATE_SIZE_8 736
 
 #define ITERATOR_INTERNAL_STATE_ALIGNMENT_16 64
-#define ITERATOR_INTERNAL_STATE_SIZE_16 2048
+#define ITERATOR_INTERNAL_STATE_SIZE_16 1472
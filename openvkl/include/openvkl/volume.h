@@ -87,6 +87,23 @@ void vklComputeSample16(const int *valid,
                         const vkl_vvec3f16 *objectCoordinates,
                         float *samples);
 
+// sample the volume at count points given in array-of-structures layout; this
+// is more efficient than the fixed-width variants for large numbers of samples
+OPENVKL_INTERFACE
+void vklComputeSampleStream(VKLVolume volume,
+                            size_t count,
+                            const vkl_vec3f *objectCoordinates,
+                            float *samples);
+
+// as above, but with coordinates given in structure-of-arrays layout
+OPENVKL_INTERFACE
+void vklComputeSampleStreamSoA(VKLVolume volume,
+                               size_t count,
+                               const float *objectCoordinatesX,
+                               const float *objectCoordinatesY,
+                               const float *objectCoordinatesZ,
+                               float *samples);
+
 OPENVKL_INTERFACE
 vkl_vec3f vklComputeGradient(VKLVolume volume,
                              const vkl_vec3f *objectCoordinates);
@@ -109,9 +126,81 @@ void vklComputeGradient16(const int *valid,
                           const vkl_vvec3f16 *objectCoordinates,
                           vkl_vvec3f16 *gradients);
 
+// compute the sample value and gradient at the same location(s) in a single
+// call; volumes may share the voxel lookups between both
+OPENVKL_INTERFACE
+float vklComputeSampleAndGradient(VKLVolume volume,
+                                  const vkl_vec3f *objectCoordinates,
+                                  vkl_vec3f *gradient);
+
+OPENVKL_INTERFACE
+void vklComputeSampleAndGradient4(const int *valid,
+                                  VKLVolume volume,
+                                  const vkl_vvec3f4 *objectCoordinates,
+                                  float *samples,
+                                  vkl_vvec3f4 *gradients);
+
+OPENVKL_INTERFACE
+void vklComputeSampleAndGradient8(const int *valid,
+                                  VKLVolume volume,
+                                  const vkl_vvec3f8 *objectCoordinates,
+                                  float *samples,
+                                  vkl_vvec3f8 *gradients);
+
+OPENVKL_INTERFACE
+void vklComputeSampleAndGradient16(const int *valid,
+                                   VKLVolume volume,
+                                   const vkl_vvec3f16 *objectCoordinates,
+                                   float *samples,
+                                   vkl_vvec3f16 *gradients);
+
+// sample M attributes of a volume at the same location(s) in a single call;
+// attributeIndices gives the M attributes to sample. the vectorized variants
+// write M * WIDTH samples, one vector of WIDTH samples per attribute.
+OPENVKL_INTERFACE
+void vklComputeSampleM(VKLVolume volume,
+                       const vkl_vec3f *objectCoordinates,
+                       float *samples,
+                       unsigned int M,
+                       const unsigned int *attributeIndices);
+
+OPENVKL_INTERFACE
+void vklComputeSampleM4(const int *valid,
+                        VKLVolume volume,
+                        const vkl_vvec3f4 *objectCoordinates,
+                        float *samples,
+                        unsigned int M,
+                        const unsigned int *attributeIndices);
+
+OPENVKL_INTERFACE
+void vklComputeSampleM8(const int *valid,
+                        VKLVolume volume,
+                        const vkl_vvec3f8 *objectCoordinates,
+                        float *samples,
+                        unsigned int M,
+                        const unsigned int *attributeIndices);
+
+OPENVKL_INTERFACE
+void vklComputeSampleM16(const int *valid,
+                         VKLVolume volume,
+                         const vkl_vvec3f16 *objectCoordinates,
+                         float *samples,
+                         unsigned int M,
+                         const unsigned int *attributeIndices);
+
+OPENVKL_INTERFACE
+unsigned int vklGetNumAttributes(VKLVolume volume);
+
 OPENVKL_INTERFACE
 vkl_box3f vklGetBoundingBox(VKLVolume volume);
 
+// mark the voxels in region (lower inclusive, upper exclusive, in voxel
+// indices) as changed; the next commit of the volume may then only update the
+// parts of its acceleration structures covering the changed regions. voxels
+// outside of all regions marked since the last commit must be unchanged.
+OPENVKL_INTERFACE
+void vklVolumeUpdateRegion(VKLVolume volume, const vkl_box3i *region);
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -14,6 +14,7 @@
 // limitations under the License.                                           //
 // ======================================================================== //
 
+#include <cmath>
 #include "../../external/catch.hpp"
 #include "openvkl_testing.h"
 
@@ -52,6 +53,46 @@ void scalar_hit_iteration(VKLVolume volume, const std::vector<float> &isoValues)
   REQUIRE(hitCount == isoValues.size());
 }
 
+// hits along the diagonal of an XYZ volume over the unit cube, where the
+// field is cubic in t: the ray from (-0.5, -0.5, -0.5) samples (t - 0.5)^3
+void scalar_hit_iteration_cubic(VKLVolume volume,
+                                const std::vector<float> &isoValues)
+{
+  vkl_vec3f origin{-0.5f, -0.5f, -0.5f};
+  vkl_vec3f direction{1.f, 1.f, 1.f};
+  vkl_range1f tRange{0.f, inf};
+
+  VKLValueSelector valueSelector = vklNewValueSelector(volume);
+
+  vklValueSelectorSetValues(valueSelector, isoValues.size(), isoValues.data());
+
+  vklCommit(valueSelector);
+
+  VKLHitIterator iterator;
+  vklInitHitIterator(
+      &iterator, volume, &origin, &direction, &tRange, valueSelector);
+
+  VKLHit hit;
+
+  size_t hitCount = 0;
+
+  while (vklIterateHit(&iterator, &hit)) {
+    INFO("hit t = " << hit.t << ", sample = " << hit.sample);
+
+    REQUIRE(hitCount < isoValues.size());
+
+    REQUIRE(hit.t ==
+            Approx(0.5f + std::cbrt(isoValues[hitCount])).margin(1e-4f));
+    REQUIRE(hit.sample == isoValues[hitCount]);
+
+    hitCount++;
+  }
+
+  REQUIRE(hitCount == isoValues.size());
+
+  vklRelease(valueSelector);
+}
+
 TEST_CASE("Hit iterator", "[hit_iterators]")
 {
   vklLoadModule("ispc_driver");
@@ -103,6 +144,23 @@ TEST_CASE("Hit iterator", "[hit_iterators]")
       scalar_hit_iteration(vklVolume, macroCellBoundaries);
     }
 
+    SECTION("structured volumes: adaptive and exact hit methods")
+    {
+      std::unique_ptr<XYZProceduralVolume> v(
+          new XYZProceduralVolume(dimensions, gridOrigin, gridSpacing));
+
+      VKLVolume vklVolume = v->getVKLVolume();
+
+      for (const char *hitMethod : {"adaptive", "exact"}) {
+        INFO("hitMethod = " << hitMethod);
+
+        vklSetString(vklVolume, "hitMethod", hitMethod);
+        vklCommit(vklVolume);
+
+        scalar_hit_iteration_cubic(vklVolume, {0.1f, 0.2f, 0.4f});
+      }
+    }
+
     SECTION("unstructured volumes")
     {
       std::unique_ptr<ZUnstructuredProceduralVolume> v(
@@ -113,5 +171,19 @@ TEST_CASE("Hit iterator", "[hit_iterators]")
 
       scalar_hit_iteration(vklVolume, defaultIsoValues);
     }
+
+    SECTION("unstructured volumes with precomputed neighbors")
+    {
+      std::unique_ptr<ZUnstructuredProceduralVolume> v(
+          new ZUnstructuredProceduralVolume(
+              dimensions, gridOrigin, gridSpacing, VKL_HEXAHEDRON, false));
+
+      VKLVolume vklVolume = v->getVKLVolume();
+
+      vklSetBool(vklVolume, "precomputedNeighbors", true);
+      vklCommit(vklVolume);
+
+      scalar_hit_iteration(vklVolume, defaultIsoValues);
+    }
   }
 }
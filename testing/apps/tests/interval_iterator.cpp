@@ -14,6 +14,10 @@
 // limitations under the License.                                           //
 // ======================================================================== //
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
 #include "../../external/catch.hpp"
 #include "iterator_utility.h"
 #include "openvkl_testing.h"
@@ -59,6 +63,72 @@ void scalar_interval_continuity_with_no_value_selector(VKLVolume volume)
   REQUIRE(intervalPrevious.tRange.upper == Approx(expectedTRange.upper));
 }
 
+// rays crossing macrocells along several axes, starting both outside and
+// inside the volume
+void scalar_interval_continuity_oblique_rays(VKLVolume volume)
+{
+  const vkl_box3f vklBoundingBox = vklGetBoundingBox(volume);
+  const box3f boundingBox        = (const box3f &)vklBoundingBox;
+
+  const vec3f center = boundingBox.center();
+  const vec3f extent = boundingBox.size();
+
+  const std::vector<vec3f> directions{vec3f(1.f, 0.7f, 0.3f),
+                                      vec3f(-0.2f, 1.f, -0.9f),
+                                      vec3f(-1.f, -1.f, -1.f)};
+
+  for (const vec3f &direction : directions) {
+    for (const float originOffset : {-2.f, -0.1f}) {
+      const vec3f origin = center + originOffset * extent * direction;
+
+      vkl_range1f tRange{0.f, inf};
+
+      // the ray starts inside the volume for the smaller offset
+      range1f expectedTRange =
+          intersectRayBox(origin, direction, boundingBox);
+      expectedTRange.lower = std::max(expectedTRange.lower, tRange.lower);
+
+      INFO("origin = " << origin.x << " " << origin.y << " " << origin.z);
+      INFO("direction = " << direction.x << " " << direction.y << " "
+                          << direction.z);
+
+      VKLIntervalIterator iterator;
+      vklInitIntervalIterator(&iterator,
+                              volume,
+                              (const vkl_vec3f *)&origin,
+                              (const vkl_vec3f *)&direction,
+                              &tRange,
+                              nullptr);
+
+      VKLInterval intervalPrevious, intervalCurrent;
+
+      int intervalCount = 0;
+
+      while (vklIterateInterval(&iterator, &intervalCurrent)) {
+        INFO("interval tRange = " << intervalCurrent.tRange.lower << ", "
+                                  << intervalCurrent.tRange.upper);
+
+        if (intervalCount == 0) {
+          REQUIRE(intervalCurrent.tRange.lower ==
+                  Approx(expectedTRange.lower).margin(1e-5f));
+        } else {
+          REQUIRE(intervalCurrent.tRange.lower ==
+                  intervalPrevious.tRange.upper);
+        }
+
+        REQUIRE(intervalCurrent.tRange.lower < intervalCurrent.tRange.upper);
+
+        intervalPrevious = intervalCurrent;
+        intervalCount++;
+      }
+
+      REQUIRE(intervalCount > 0);
+      REQUIRE(intervalPrevious.tRange.upper ==
+              Approx(expectedTRange.upper).margin(1e-5f));
+    }
+  }
+}
+
 void scalar_interval_value_ranges_with_no_value_selector(VKLVolume volume)
 {
   vkl_vec3f origin{0.5f, 0.5f, -1.f};
@@ -217,6 +287,608 @@ void scalar_interval_nominalDeltaT(VKLVolume volume,
   REQUIRE(interval.nominalDeltaT == Approx(expectedNominalDeltaT));
 }
 
+// wavelet volume on a rectilinear grid over the unit cube, with cells growing
+// quadratically along each axis
+VKLVolume newGradedWaveletRectilinearVolume(const vec3i &dimensions)
+{
+  const int numVertices[3] = {dimensions.x, dimensions.y, dimensions.z};
+
+  std::vector<float> coordinates[3];
+
+  for (int axis = 0; axis < 3; axis++) {
+    coordinates[axis].resize(numVertices[axis]);
+
+    for (int i = 0; i < numVertices[axis]; i++) {
+      const float t        = float(i) / float(numVertices[axis] - 1);
+      coordinates[axis][i] = t * t;
+    }
+  }
+
+  std::vector<float> voxels(longProduct(dimensions));
+
+  for (int z = 0; z < dimensions.z; z++)
+    for (int y = 0; y < dimensions.y; y++)
+      for (int x = 0; x < dimensions.x; x++)
+        voxels[(size_t(z) * dimensions.y + y) * dimensions.x + x] =
+            getWaveletValue<float>(vec3f(
+                coordinates[0][x], coordinates[1][y], coordinates[2][z]));
+
+  VKLVolume volume = vklNewVolume("structured_rectilinear");
+
+  vklSetVec3i(volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+
+  const char *coordinateNames[3] = {
+      "xCoordinates", "yCoordinates", "zCoordinates"};
+
+  for (int axis = 0; axis < 3; axis++) {
+    VKLData data = vklNewData(
+        coordinates[axis].size(), VKL_FLOAT, coordinates[axis].data());
+    vklSetData(volume, coordinateNames[axis], data);
+    vklRelease(data);
+  }
+
+  VKLData voxelData = vklNewData(voxels.size(), VKL_FLOAT, voxels.data());
+  vklSetData(volume, "voxelData", voxelData);
+  vklRelease(voxelData);
+
+  vklCommit(volume);
+
+  return volume;
+}
+
+// wavelet volume on a spherical grid covering the ball of radius 1 around the
+// origin
+VKLVolume newWaveletSphericalVolume()
+{
+  const vec3i dimensions(64, 37, 73);
+  const vec3f gridOrigin(0.f);
+  const vec3f gridSpacing(1.f / 63.f, 5.f, 5.f);
+
+  const float degreesToRadians = 3.14159265f / 180.f;
+
+  std::vector<float> voxels(longProduct(dimensions));
+
+  for (int z = 0; z < dimensions.z; z++) {
+    for (int y = 0; y < dimensions.y; y++) {
+      for (int x = 0; x < dimensions.x; x++) {
+        const vec3f spherical = gridOrigin + vec3f(x, y, z) * gridSpacing;
+
+        const float inclination = spherical.y * degreesToRadians;
+        const float azimuth     = spherical.z * degreesToRadians;
+
+        const vec3f objectCoordinates =
+            spherical.x * vec3f(std::sin(inclination) * std::cos(azimuth),
+                                std::sin(inclination) * std::sin(azimuth),
+                                std::cos(inclination));
+
+        voxels[(size_t(z) * dimensions.y + y) * dimensions.x + x] =
+            getWaveletValue<float>(objectCoordinates);
+      }
+    }
+  }
+
+  VKLVolume volume = vklNewVolume("structured_spherical");
+
+  vklSetVec3i(volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+  vklSetVec3f(volume, "gridOrigin", gridOrigin.x, gridOrigin.y, gridOrigin.z);
+  vklSetVec3f(
+      volume, "gridSpacing", gridSpacing.x, gridSpacing.y, gridSpacing.z);
+
+  VKLData voxelData = vklNewData(voxels.size(), VKL_FLOAT, voxels.data());
+  vklSetData(volume, "voxelData", voxelData);
+  vklRelease(voxelData);
+
+  vklCommit(volume);
+
+  return volume;
+}
+
+// intervals of spherical volumes start and end on the sphere, rather than the
+// bounding box
+void scalar_interval_continuity_spherical(VKLVolume volume)
+{
+  vkl_vec3f origin{0.5f, 0.5f, -1.f};
+  vkl_vec3f direction{0.f, 0.f, 1.f};
+  vkl_range1f tRange{0.f, inf};
+
+  // ray enters and exits the unit sphere at z = -/+ sqrt(0.5)
+  const float halfChord = std::sqrt(0.5f);
+  const range1f expectedTRange(1.f - halfChord, 1.f + halfChord);
+
+  VKLIntervalIterator iterator;
+  vklInitIntervalIterator(
+      &iterator, volume, &origin, &direction, &tRange, nullptr);
+
+  VKLInterval intervalPrevious, intervalCurrent;
+
+  int intervalCount = 0;
+
+  for (int i = 0; vklIterateInterval(&iterator, &intervalCurrent); i++) {
+    INFO("interval tRange = " << intervalCurrent.tRange.lower << ", "
+                              << intervalCurrent.tRange.upper);
+
+    if (i == 0) {
+      REQUIRE(intervalCurrent.tRange.lower ==
+              Approx(expectedTRange.lower).margin(1e-4f));
+    } else {
+      REQUIRE(intervalCurrent.tRange.lower == intervalPrevious.tRange.upper);
+    }
+
+    REQUIRE(intervalCurrent.tRange.lower < intervalCurrent.tRange.upper);
+
+    intervalPrevious = intervalCurrent;
+    intervalCount++;
+  }
+
+  REQUIRE(intervalCount > 0);
+
+  REQUIRE(intervalPrevious.tRange.upper ==
+          Approx(expectedTRange.upper).margin(1e-4f));
+}
+
+// a mostly empty volume, with isolated nonzero voxels in a few macrocells
+// spread over several bricks of macrocells; the intervals selecting those
+// voxels must be found on either side of skipped empty regions
+template <typename VOXEL_TYPE>
+void scalar_interval_sparse_volume_with_value_selector(int macrocellSize)
+{
+  const vec3i dimensions(1025, 17, 17);
+
+  std::vector<VOXEL_TYPE> voxels(longProduct(dimensions), VOXEL_TYPE(0));
+
+  // not on a macrocell boundary for any of the tested macrocell sizes
+  const std::vector<int> nonzeroVoxels{101, 901, 1021};
+
+  for (const int x : nonzeroVoxels)
+    voxels[(size_t(8) * dimensions.y + 8) * dimensions.x + x] = VOXEL_TYPE(1);
+
+  VKLVolume volume = vklNewVolume("structured_regular");
+
+  vklSetVec3i(volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+  vklSetInt(volume, "macrocellSize", macrocellSize);
+
+  VKLData voxelData = vklNewData(
+      voxels.size(), getVKLDataType<VOXEL_TYPE>(), voxels.data());
+  vklSetData(volume, "voxelData", voxelData);
+  vklRelease(voxelData);
+
+  vklCommit(volume);
+
+  VKLValueSelector valueSelector = vklNewValueSelector(volume);
+
+  vkl_range1f valueRange{0.5f, 1.5f};
+  vklValueSelectorSetRanges(valueSelector, 1, &valueRange);
+  vklCommit(valueSelector);
+
+  for (const float directionX : {1.f, -1.f}) {
+    INFO("direction.x = " << directionX);
+
+    vkl_vec3f origin{directionX > 0.f ? -1.f : 1026.f, 8.f, 8.f};
+    vkl_vec3f direction{directionX, 0.f, 0.f};
+    vkl_range1f tRange{0.f, inf};
+
+    // the macrocell of each nonzero voxel, in traversal order
+    std::vector<range1f> expectedTRanges;
+
+    for (const int x : nonzeroVoxels) {
+      const float cellLower = float(x / macrocellSize * macrocellSize);
+      const float cellUpper = cellLower + float(macrocellSize);
+
+      expectedTRanges.push_back(
+          directionX > 0.f
+              ? range1f(cellLower - origin.x, cellUpper - origin.x)
+              : range1f(origin.x - cellUpper, origin.x - cellLower));
+    }
+
+    if (directionX < 0.f)
+      std::reverse(expectedTRanges.begin(), expectedTRanges.end());
+
+    VKLIntervalIterator iterator;
+    vklInitIntervalIterator(
+        &iterator, volume, &origin, &direction, &tRange, valueSelector);
+
+    VKLInterval interval;
+
+    size_t intervalCount = 0;
+
+    while (vklIterateInterval(&iterator, &interval)) {
+      INFO("interval tRange = " << interval.tRange.lower << ", "
+                                << interval.tRange.upper);
+
+      REQUIRE(intervalCount < expectedTRanges.size());
+
+      REQUIRE(interval.tRange.lower ==
+              Approx(expectedTRanges[intervalCount].lower));
+      REQUIRE(interval.tRange.upper ==
+              Approx(expectedTRanges[intervalCount].upper));
+
+      // value ranges may be quantized conservatively, but are exact for
+      // integer voxel types
+      REQUIRE(interval.valueRange.lower <= 0.f);
+      REQUIRE(interval.valueRange.upper >= 1.f);
+
+      if (std::is_integral<VOXEL_TYPE>::value) {
+        REQUIRE(interval.valueRange.lower == 0.f);
+        REQUIRE(interval.valueRange.upper == 1.f);
+      } else {
+        REQUIRE(interval.valueRange.lower == Approx(0.f).margin(1e-4f));
+        REQUIRE(interval.valueRange.upper == Approx(1.f).margin(1e-4f));
+      }
+
+      intervalCount++;
+    }
+
+    REQUIRE(intervalCount == expectedTRanges.size());
+  }
+
+  vklRelease(valueSelector);
+  vklRelease(volume);
+}
+
+// number of intervals along the x axis through the voxel row (y, z) = (8, 8)
+// selecting values in [0.5, 1.5]
+size_t scalar_interval_count_selected(VKLVolume volume, float originX)
+{
+  VKLValueSelector valueSelector = vklNewValueSelector(volume);
+
+  vkl_range1f valueRange{0.5f, 1.5f};
+  vklValueSelectorSetRanges(valueSelector, 1, &valueRange);
+  vklCommit(valueSelector);
+
+  vkl_vec3f origin{originX, 8.f, 8.f};
+  vkl_vec3f direction{1.f, 0.f, 0.f};
+  vkl_range1f tRange{0.f, inf};
+
+  VKLIntervalIterator iterator;
+  vklInitIntervalIterator(
+      &iterator, volume, &origin, &direction, &tRange, valueSelector);
+
+  VKLInterval interval;
+
+  size_t intervalCount = 0;
+
+  while (vklIterateInterval(&iterator, &interval))
+    intervalCount++;
+
+  vklRelease(valueSelector);
+
+  return intervalCount;
+}
+
+// voxels of a volume sharing the application's buffer are changed in place,
+// and the accelerator is refit for the changed region on the next commit
+void scalar_interval_refit_with_value_selector(
+    int macrocellSize, const std::string &layout = "linear")
+{
+  const vec3i dimensions(257, 17, 17);
+
+  std::vector<float> voxels(longProduct(dimensions), 0.f);
+
+  VKLVolume volume = vklNewVolume("structured_regular");
+
+  vklSetVec3i(volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+  vklSetInt(volume, "macrocellSize", macrocellSize);
+  vklSetString(volume, "layout", layout.c_str());
+
+  VKLData voxelData = vklNewData(
+      voxels.size(), VKL_FLOAT, voxels.data(), VKL_DATA_SHARED_BUFFER);
+  vklSetData(volume, "voxelData", voxelData);
+  vklRelease(voxelData);
+
+  vklCommit(volume);
+
+  REQUIRE(scalar_interval_count_selected(volume, -1.f) == 0);
+
+  auto setVoxel = [&](int x, float value) {
+    voxels[(size_t(8) * dimensions.y + 8) * dimensions.x + x] = value;
+
+    const vkl_box3i region{{x, 8, 8}, {x + 1, 9, 9}};
+    vklVolumeUpdateRegion(volume, &region);
+  };
+
+  auto sampleVoxel = [&](int x) {
+    const vkl_vec3f objectCoordinates{float(x), 8.f, 8.f};
+    return vklComputeSample(volume, &objectCoordinates);
+  };
+
+  // within the value range of the volume at the last build
+  setVoxel(101, 1.f);
+  vklCommit(volume);
+
+  REQUIRE(scalar_interval_count_selected(volume, -1.f) == 1);
+  REQUIRE(sampleVoxel(101) == 1.f);
+
+  setVoxel(101, 0.f);
+  setVoxel(201, 1.f);
+  vklCommit(volume);
+
+  REQUIRE(scalar_interval_count_selected(volume, -1.f) == 1);
+  REQUIRE(scalar_interval_count_selected(volume, 150.f) == 1);
+  REQUIRE(scalar_interval_count_selected(volume, 210.f) == 0);
+  REQUIRE(sampleVoxel(101) == 0.f);
+  REQUIRE(sampleVoxel(201) == 1.f);
+
+  // far outside of the value range, which requires a rebuild
+  setVoxel(31, 1e6f);
+  setVoxel(51, 1.f);
+  vklCommit(volume);
+
+  REQUIRE(scalar_interval_count_selected(volume, -1.f) == 3);
+  REQUIRE(sampleVoxel(31) == 1e6f);
+
+  vklRelease(volume);
+}
+
+// the voxel data and accelerator are rebuilt completely if the layout or voxel
+// type changed, even with regions marked as updated
+void scalar_interval_refit_after_configuration_change()
+{
+  const vec3i dimensions(257, 17, 17);
+
+  std::vector<float> voxels(longProduct(dimensions), 0.f);
+
+  VKLVolume volume = vklNewVolume("structured_regular");
+
+  vklSetVec3i(volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+
+  VKLData voxelData = vklNewData(
+      voxels.size(), VKL_FLOAT, voxels.data(), VKL_DATA_SHARED_BUFFER);
+  vklSetData(volume, "voxelData", voxelData);
+  vklRelease(voxelData);
+
+  vklCommit(volume);
+
+  REQUIRE(scalar_interval_count_selected(volume, -1.f) == 0);
+
+  const size_t rowOffset = (size_t(8) * dimensions.y + 8) * dimensions.x;
+
+  auto markVoxel = [&](int x) {
+    const vkl_box3i region{{x, 8, 8}, {x + 1, 9, 9}};
+    vklVolumeUpdateRegion(volume, &region);
+  };
+
+  auto sampleVoxel = [&](int x) {
+    const vkl_vec3f objectCoordinates{float(x), 8.f, 8.f};
+    return vklComputeSample(volume, &objectCoordinates);
+  };
+
+  // only one of the changed voxels is marked, along with a layout change
+  voxels[rowOffset + 101] = 1.f;
+  voxels[rowOffset + 201] = 1.f;
+  markVoxel(101);
+
+  vklSetString(volume, "layout", "bricked");
+  vklCommit(volume);
+
+  REQUIRE(scalar_interval_count_selected(volume, -1.f) == 2);
+  REQUIRE(sampleVoxel(201) == 1.f);
+
+  // new voxel data of another type, again with only one changed voxel marked
+  std::vector<unsigned char> voxelsUChar(longProduct(dimensions), 0);
+  voxelsUChar[rowOffset + 51]  = 1;
+  voxelsUChar[rowOffset + 151] = 1;
+
+  voxelData = vklNewData(voxelsUChar.size(), VKL_UCHAR, voxelsUChar.data());
+  vklSetData(volume, "voxelData", voxelData);
+  vklRelease(voxelData);
+
+  markVoxel(51);
+  vklCommit(volume);
+
+  REQUIRE(scalar_interval_count_selected(volume, -1.f) == 2);
+  REQUIRE(scalar_interval_count_selected(volume, 100.f) == 1);
+  REQUIRE(sampleVoxel(101) == 0.f);
+  REQUIRE(sampleVoxel(151) == 1.f);
+
+  vklRelease(volume);
+}
+
+// with voxel interval resolution, each voxel having a nonzero corner is
+// returned as a separate interval, with the exact value range of its corners
+void scalar_interval_voxel_resolution_with_value_selector()
+{
+  const vec3i dimensions(257, 17, 17);
+
+  std::vector<float> voxels(longProduct(dimensions), 0.f);
+
+  const std::vector<int> nonzeroVoxels{101, 201};
+
+  for (const int x : nonzeroVoxels)
+    voxels[(size_t(8) * dimensions.y + 8) * dimensions.x + x] = 1.f;
+
+  VKLVolume volume = vklNewVolume("structured_regular");
+
+  vklSetVec3i(volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+  vklSetString(volume, "intervalResolution", "voxel");
+
+  VKLData voxelData = vklNewData(voxels.size(), VKL_FLOAT, voxels.data());
+  vklSetData(volume, "voxelData", voxelData);
+  vklRelease(voxelData);
+
+  vklCommit(volume);
+
+  VKLValueSelector valueSelector = vklNewValueSelector(volume);
+
+  vkl_range1f valueRange{0.5f, 1.5f};
+  vklValueSelectorSetRanges(valueSelector, 1, &valueRange);
+  vklCommit(valueSelector);
+
+  for (const float directionX : {1.f, -1.f}) {
+    INFO("direction.x = " << directionX);
+
+    vkl_vec3f origin{directionX > 0.f ? -1.f : 258.f, 8.f, 8.f};
+    vkl_vec3f direction{directionX, 0.f, 0.f};
+    vkl_range1f tRange{0.f, inf};
+
+    // the two voxels sharing each nonzero voxel as a corner, in traversal
+    // order
+    std::vector<range1f> expectedTRanges;
+
+    for (const int x : nonzeroVoxels) {
+      for (const int voxelLower : {x - 1, x}) {
+        const float voxelUpper = float(voxelLower + 1);
+
+        expectedTRanges.push_back(
+            directionX > 0.f
+                ? range1f(float(voxelLower) - origin.x, voxelUpper - origin.x)
+                : range1f(origin.x - voxelUpper,
+                          origin.x - float(voxelLower)));
+      }
+    }
+
+    if (directionX < 0.f)
+      std::reverse(expectedTRanges.begin(), expectedTRanges.end());
+
+    VKLIntervalIterator iterator;
+    vklInitIntervalIterator(
+        &iterator, volume, &origin, &direction, &tRange, valueSelector);
+
+    VKLInterval interval;
+
+    size_t intervalCount = 0;
+
+    while (vklIterateInterval(&iterator, &interval)) {
+      INFO("interval tRange = " << interval.tRange.lower << ", "
+                                << interval.tRange.upper);
+
+      REQUIRE(intervalCount < expectedTRanges.size());
+
+      REQUIRE(interval.tRange.lower ==
+              Approx(expectedTRanges[intervalCount].lower));
+      REQUIRE(interval.tRange.upper ==
+              Approx(expectedTRanges[intervalCount].upper));
+
+      REQUIRE(interval.valueRange.lower == 0.f);
+      REQUIRE(interval.valueRange.upper == 1.f);
+
+      intervalCount++;
+    }
+
+    REQUIRE(intervalCount == expectedTRanges.size());
+  }
+
+  vklRelease(valueSelector);
+  vklRelease(volume);
+}
+
+// iterators store their state in the leading vklGetIntervalIteratorSize()
+// bytes of internalState, and may be relocated by copying only these bytes
+void scalar_interval_relocated_iterator_state(VKLVolume volume)
+{
+  const size_t iteratorSize = vklGetIntervalIteratorSize(volume);
+
+  REQUIRE(iteratorSize > 0);
+  REQUIRE(iteratorSize <= sizeof(VKLIntervalIterator::internalState));
+
+  const vkl_box3f vklBoundingBox = vklGetBoundingBox(volume);
+  const box3f boundingBox        = (const box3f &)vklBoundingBox;
+
+  const vec3f direction = normalize(vec3f(1.f, 0.7f, 0.3f));
+  const float distance  = length(boundingBox.size());
+  const vec3f origin    = boundingBox.center() - distance * direction;
+
+  vkl_range1f tRange{0.f, inf};
+
+  VKLIntervalIterator reference;
+  vklInitIntervalIterator(&reference,
+                          volume,
+                          (const vkl_vec3f *)&origin,
+                          (const vkl_vec3f *)&direction,
+                          &tRange,
+                          nullptr);
+
+  VKLIntervalIterator iterator;
+  vklInitIntervalIterator(&iterator,
+                          volume,
+                          (const vkl_vec3f *)&origin,
+                          (const vkl_vec3f *)&direction,
+                          &tRange,
+                          nullptr);
+
+  std::vector<char> storedState(iteratorSize);
+
+  VKLInterval intervalReference, interval;
+
+  int intervalCount = 0;
+
+  while (vklIterateInterval(&reference, &intervalReference)) {
+    // store only the used part of the state, and continue from a fresh
+    // iterator object with garbage in the remaining bytes
+    std::memcpy(storedState.data(), iterator.internalState, iteratorSize);
+
+    VKLIntervalIterator relocated;
+    std::memset(&relocated, 0xff, sizeof(relocated));
+    std::memcpy(relocated.internalState, storedState.data(), iteratorSize);
+    relocated.volume = volume;
+
+    REQUIRE(vklIterateInterval(&relocated, &interval));
+
+    REQUIRE(interval.tRange.lower == intervalReference.tRange.lower);
+    REQUIRE(interval.tRange.upper == intervalReference.tRange.upper);
+    REQUIRE(interval.valueRange.lower == intervalReference.valueRange.lower);
+    REQUIRE(interval.valueRange.upper == intervalReference.valueRange.upper);
+    REQUIRE(interval.nominalDeltaT == intervalReference.nominalDeltaT);
+
+    iterator = relocated;
+
+    intervalCount++;
+  }
+
+  REQUIRE(intervalCount > 0);
+  REQUIRE(!vklIterateInterval(&iterator, &interval));
+}
+
+// unstructured volumes return BVH nodes up to a maximum depth as intervals:
+// the root node at depth 0, and more, shorter intervals at larger depths
+void scalar_interval_unstructured_iterator_depth(VKLVolume volume)
+{
+  const vkl_box3f vklBoundingBox = vklGetBoundingBox(volume);
+  const box3f boundingBox        = (const box3f &)vklBoundingBox;
+
+  vkl_vec3f origin{0.5f, 0.5f, -1.f};
+  vkl_vec3f direction{0.f, 0.f, 1.f};
+  vkl_range1f tRange{0.f, inf};
+
+  const range1f expectedTRange = intersectRayBox(
+      (const vec3f &)origin, (const vec3f &)direction, boundingBox);
+
+  int previousIntervalCount = 0;
+
+  for (const int maxIteratorDepth : {0, 4, 8}) {
+    INFO("maxIteratorDepth = " << maxIteratorDepth);
+
+    vklSetInt(volume, "maxIteratorDepth", maxIteratorDepth);
+    vklCommit(volume);
+
+    scalar_interval_continuity_with_no_value_selector(volume);
+
+    VKLIntervalIterator iterator;
+    vklInitIntervalIterator(
+        &iterator, volume, &origin, &direction, &tRange, nullptr);
+
+    VKLInterval interval;
+
+    int intervalCount = 0;
+
+    while (vklIterateInterval(&iterator, &interval)) {
+      if (maxIteratorDepth == 0) {
+        REQUIRE(interval.tRange.lower == Approx(expectedTRange.lower));
+        REQUIRE(interval.tRange.upper == Approx(expectedTRange.upper));
+      }
+
+      intervalCount++;
+    }
+
+    if (maxIteratorDepth == 0) {
+      REQUIRE(intervalCount == 1);
+    } else {
+      REQUIRE(intervalCount > previousIntervalCount);
+    }
+
+    previousIntervalCount = intervalCount;
+  }
+}
+
 TEST_CASE("Interval iterator", "[interval_iterators]")
 {
   vklLoadModule("ispc_driver");
@@ -242,6 +914,11 @@ TEST_CASE("Interval iterator", "[interval_iterators]")
       scalar_interval_continuity_with_no_value_selector(vklVolume);
     }
 
+    SECTION("scalar interval continuity along oblique rays")
+    {
+      scalar_interval_continuity_oblique_rays(vklVolume);
+    }
+
     SECTION("scalar interval value ranges with no value selector")
     {
       scalar_interval_value_ranges_with_no_value_selector(vklVolume);
@@ -251,6 +928,171 @@ TEST_CASE("Interval iterator", "[interval_iterators]")
     {
       scalar_interval_value_ranges_with_value_selector(vklVolume);
     }
+
+    SECTION("scalar interval relocated iterator state")
+    {
+      scalar_interval_relocated_iterator_state(vklVolume);
+    }
+  }
+
+  SECTION("compressed structured volumes")
+  {
+    const vec3i dimensions(128);
+    const vec3f gridOrigin(0.f);
+    const vec3f gridSpacing(1.f / (128.f - 1.f));
+
+    std::unique_ptr<WaveletProceduralVolume> v(
+        new WaveletProceduralVolume(dimensions,
+                                    gridOrigin,
+                                    gridSpacing,
+                                    "structured_regular_compressed"));
+
+    VKLVolume vklVolume = v->getVKLVolume();
+
+    SECTION("scalar interval continuity with no value selector")
+    {
+      scalar_interval_continuity_with_no_value_selector(vklVolume);
+    }
+
+    SECTION("scalar interval value ranges with no value selector")
+    {
+      scalar_interval_value_ranges_with_no_value_selector(vklVolume);
+    }
+
+    SECTION("scalar interval value ranges with value selector")
+    {
+      scalar_interval_value_ranges_with_value_selector(vklVolume);
+    }
+  }
+
+  SECTION("rectilinear structured volumes")
+  {
+    VKLVolume vklVolume = newGradedWaveletRectilinearVolume(vec3i(128));
+
+    SECTION("scalar interval continuity with no value selector")
+    {
+      scalar_interval_continuity_with_no_value_selector(vklVolume);
+    }
+
+    SECTION("scalar interval continuity along oblique rays")
+    {
+      scalar_interval_continuity_oblique_rays(vklVolume);
+    }
+
+    SECTION("scalar interval value ranges with no value selector")
+    {
+      scalar_interval_value_ranges_with_no_value_selector(vklVolume);
+    }
+
+    SECTION("scalar interval relocated iterator state")
+    {
+      scalar_interval_relocated_iterator_state(vklVolume);
+    }
+
+    vklRelease(vklVolume);
+  }
+
+  SECTION("spherical structured volumes")
+  {
+    VKLVolume vklVolume = newWaveletSphericalVolume();
+
+    SECTION("scalar interval continuity with no value selector")
+    {
+      scalar_interval_continuity_spherical(vklVolume);
+    }
+
+    SECTION("scalar interval value ranges with no value selector")
+    {
+      scalar_interval_value_ranges_with_no_value_selector(vklVolume);
+    }
+
+    vklRelease(vklVolume);
+  }
+
+  SECTION("sparse structured volumes")
+  {
+    SECTION("scalar interval skipping with value selector")
+    {
+      scalar_interval_sparse_volume_with_value_selector<float>(16);
+    }
+
+    SECTION("scalar interval skipping with value selector, small macrocells")
+    {
+      scalar_interval_sparse_volume_with_value_selector<float>(4);
+    }
+
+    SECTION("scalar interval skipping with value selector, large macrocells")
+    {
+      scalar_interval_sparse_volume_with_value_selector<float>(64);
+    }
+
+    SECTION("scalar interval skipping with value selector, unsigned char")
+    {
+      scalar_interval_sparse_volume_with_value_selector<unsigned char>(16);
+    }
+  }
+
+  SECTION("structured volumes: accelerator refit for updated regions")
+  {
+    SECTION("scalar interval refit with value selector")
+    {
+      scalar_interval_refit_with_value_selector(16);
+    }
+
+    SECTION("scalar interval refit with value selector, small macrocells")
+    {
+      scalar_interval_refit_with_value_selector(4);
+    }
+
+    SECTION("scalar interval refit with value selector, bricked layout")
+    {
+      scalar_interval_refit_with_value_selector(16, "bricked");
+    }
+
+    SECTION("scalar interval refit after layout and voxel type changes")
+    {
+      scalar_interval_refit_after_configuration_change();
+    }
+  }
+
+  SECTION("structured volumes: voxel interval resolution")
+  {
+    const vec3i dimensions(128);
+    const vec3f gridOrigin(0.f);
+    const vec3f gridSpacing(1.f / (128.f - 1.f));
+
+    std::unique_ptr<WaveletProceduralVolume> v(
+        new WaveletProceduralVolume(dimensions, gridOrigin, gridSpacing));
+
+    VKLVolume vklVolume = v->getVKLVolume();
+
+    vklSetString(vklVolume, "intervalResolution", "voxel");
+    vklCommit(vklVolume);
+
+    SECTION("scalar interval continuity with no value selector")
+    {
+      scalar_interval_continuity_with_no_value_selector(vklVolume);
+    }
+
+    SECTION("scalar interval continuity along oblique rays")
+    {
+      scalar_interval_continuity_oblique_rays(vklVolume);
+    }
+
+    SECTION("scalar interval value ranges with no value selector")
+    {
+      scalar_interval_value_ranges_with_no_value_selector(vklVolume);
+    }
+
+    SECTION("scalar interval value ranges with value selector")
+    {
+      scalar_interval_value_ranges_with_value_selector(vklVolume);
+    }
+
+    SECTION("scalar voxel intervals with value selector")
+    {
+      scalar_interval_voxel_resolution_with_value_selector();
+    }
   }
 
   SECTION("structured volumes: interval nominalDeltaT")
@@ -354,5 +1196,15 @@ TEST_CASE("Interval iterator", "[interval_iterators]")
     {
       scalar_interval_value_ranges_with_value_selector(vklVolume);
     }
+
+    SECTION("scalar interval relocated iterator state")
+    {
+      scalar_interval_relocated_iterator_state(vklVolume);
+    }
+
+    SECTION("scalar interval iterator depth")
+    {
+      scalar_interval_unstructured_iterator_depth(vklVolume);
+    }
   }
 }
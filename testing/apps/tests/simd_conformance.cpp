@@ -17,7 +17,9 @@
 #include "../../external/catch.hpp"
 #include "../common/simd.h"
 #include "openvkl/drivers/ispc/GridAcceleratorIterator_ispc.h"
+#include "openvkl/drivers/ispc/UnstructuredIterator_ispc.h"
 #include "openvkl/drivers/ispc/iterator/GridAcceleratorIterator.h"
+#include "openvkl/drivers/ispc/iterator/UnstructuredIterator.h"
 #include "openvkl/drivers/ispc/simd_conformance_ispc.h"
 #include "openvkl_testing.h"
 
@@ -64,11 +66,19 @@ void vVKLIntervalIteratorN_conformance_test()
             alignof(vVKLIntervalIteratorN<W>));
 
     // special case: scalar ray iterator should match size of maximum width
-    // (16); alignment doesn't matter since the conversions make copies.
+    // (16).
     REQUIRE(sizeof(VKLIntervalIterator) == sizeof(vVKLIntervalIteratorN<W>));
   } else {
     throw std::runtime_error("unsupported native SIMD width for tests");
   }
+
+  // scalar iterators hold native-width iterators in place, so must be sized
+  // and aligned for them
+  REQUIRE(sizeof(VKLIntervalIterator) == sizeof(vVKLIntervalIteratorN<1>));
+  REQUIRE(alignof(VKLIntervalIterator) == alignof(vVKLIntervalIteratorN<1>));
+  REQUIRE(sizeof(vVKLIntervalIteratorN<1>) >= sizeof(vVKLIntervalIteratorN<W>));
+  REQUIRE(alignof(vVKLIntervalIteratorN<1>) >=
+          alignof(vVKLIntervalIteratorN<W>));
 }
 
 template <int W>
@@ -91,11 +101,18 @@ void vVKLHitIteratorN_conformance_test()
     REQUIRE(alignof(VKLHitIterator16) == alignof(vVKLHitIteratorN<W>));
 
     // special case: scalar ray iterator should match size of maximum width
-    // (16); alignment doesn't matter since the conversions make copies.
+    // (16).
     REQUIRE(sizeof(VKLHitIterator) == sizeof(vVKLHitIteratorN<W>));
   } else {
     throw std::runtime_error("unsupported native SIMD width for tests");
   }
+
+  // scalar iterators hold native-width iterators in place, so must be sized
+  // and aligned for them
+  REQUIRE(sizeof(VKLHitIterator) == sizeof(vVKLHitIteratorN<1>));
+  REQUIRE(alignof(VKLHitIterator) == alignof(vVKLHitIteratorN<1>));
+  REQUIRE(sizeof(vVKLHitIteratorN<1>) >= sizeof(vVKLHitIteratorN<W>));
+  REQUIRE(alignof(vVKLHitIteratorN<1>) >= alignof(vVKLHitIteratorN<W>));
 }
 
 template <int W>
@@ -115,16 +132,62 @@ void vVKLHitN_conformance_test()
 }
 
 template <int W>
-void GridAcceleratorIterator_conformance_test()
+void GridAcceleratorIntervalIterator_conformance_test()
+{
+  using openvkl::ispc_driver::GridAcceleratorIntervalIterator;
+
+  int ispcSize = ispc::GridAcceleratorIntervalIterator_sizeOf();
+  REQUIRE(ispcSize == GridAcceleratorIntervalIterator<W>::ispcStorageSize);
+
+  REQUIRE(is_aligned_for_type<GridAcceleratorIntervalIterator<W>>(
+      ispc::GridAcceleratorIntervalIterator_new()));
+
+  REQUIRE(sizeof(GridAcceleratorIntervalIterator<W>) <=
+          iterator_internal_state_size_for_width(W));
+}
+
+template <int W>
+void GridAcceleratorHitIterator_conformance_test()
 {
-  int ispcSize = ispc::GridAcceleratorIterator_sizeOf();
-  REQUIRE(ispcSize ==
-          openvkl::ispc_driver::GridAcceleratorIterator<W>::ispcStorageSize);
+  using openvkl::ispc_driver::GridAcceleratorHitIterator;
+
+  int ispcSize = ispc::GridAcceleratorHitIterator_sizeOf();
+  REQUIRE(ispcSize == GridAcceleratorHitIterator<W>::ispcStorageSize);
+
+  REQUIRE(is_aligned_for_type<GridAcceleratorHitIterator<W>>(
+      ispc::GridAcceleratorHitIterator_new()));
+
+  REQUIRE(sizeof(GridAcceleratorHitIterator<W>) <=
+          iterator_internal_state_size_for_width(W));
+}
+
+template <int W>
+void UnstructuredIntervalIterator_conformance_test()
+{
+  using openvkl::ispc_driver::UnstructuredIntervalIterator;
+
+  int ispcSize = ispc::UnstructuredIntervalIterator_sizeOf();
+  REQUIRE(ispcSize == UnstructuredIntervalIterator<W>::ispcStorageSize);
+
+  REQUIRE(is_aligned_for_type<UnstructuredIntervalIterator<W>>(
+      ispc::UnstructuredIntervalIterator_new()));
+
+  REQUIRE(sizeof(UnstructuredIntervalIterator<W>) <=
+          iterator_internal_state_size_for_width(W));
+}
+
+template <int W>
+void UnstructuredHitIterator_conformance_test()
+{
+  using openvkl::ispc_driver::UnstructuredHitIterator;
+
+  int ispcSize = ispc::UnstructuredHitIterator_sizeOf();
+  REQUIRE(ispcSize == UnstructuredHitIterator<W>::ispcStorageSize);
 
-  REQUIRE(is_aligned_for_type<openvkl::ispc_driver::GridAcceleratorIterator<W>>(
-      ispc::GridAcceleratorIterator_new()));
+  REQUIRE(is_aligned_for_type<UnstructuredHitIterator<W>>(
+      ispc::UnstructuredHitIterator_new()));
 
-  REQUIRE(sizeof(openvkl::ispc_driver::GridAcceleratorIterator<W>) <=
+  REQUIRE(sizeof(UnstructuredHitIterator<W>) <=
           iterator_internal_state_size_for_width(W));
 }
 
@@ -150,7 +213,10 @@ TEST_CASE("SIMD conformance", "[simd_conformance]")
       vVKLHitIteratorN_conformance_test<4>();
       vVKLIntervalN_conformance_test<4>();
       vVKLHitN_conformance_test<4>();
-      GridAcceleratorIterator_conformance_test<4>();
+      GridAcceleratorIntervalIterator_conformance_test<4>();
+      GridAcceleratorHitIterator_conformance_test<4>();
+      UnstructuredIntervalIterator_conformance_test<4>();
+      UnstructuredHitIterator_conformance_test<4>();
     }
   }
 
@@ -163,7 +229,10 @@ TEST_CASE("SIMD conformance", "[simd_conformance]")
       vVKLHitIteratorN_conformance_test<8>();
       vVKLIntervalN_conformance_test<8>();
       vVKLHitN_conformance_test<8>();
-      GridAcceleratorIterator_conformance_test<8>();
+      GridAcceleratorIntervalIterator_conformance_test<8>();
+      GridAcceleratorHitIterator_conformance_test<8>();
+      UnstructuredIntervalIterator_conformance_test<8>();
+      UnstructuredHitIterator_conformance_test<8>();
     }
   }
 
@@ -176,7 +245,10 @@ TEST_CASE("SIMD conformance", "[simd_conformance]")
       vVKLHitIteratorN_conformance_test<16>();
       vVKLIntervalN_conformance_test<16>();
       vVKLHitN_conformance_test<16>();
-      GridAcceleratorIterator_conformance_test<16>();
+      GridAcceleratorIntervalIterator_conformance_test<16>();
+      GridAcceleratorHitIterator_conformance_test<16>();
+      UnstructuredIntervalIterator_conformance_test<16>();
+      UnstructuredHitIterator_conformance_test<16>();
     }
   }
 
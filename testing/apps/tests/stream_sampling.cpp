@@ -0,0 +1,97 @@
+// ======================================================================== //
+// Copyright 2019 Intel Corporation                                         //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "../../external/catch.hpp"
+#include "openvkl_testing.h"
+
+using namespace ospcommon;
+using namespace openvkl::testing;
+
+template <typename VOLUME_TYPE>
+void test_stream_sampling()
+{
+  std::unique_ptr<VOLUME_TYPE> v(
+      new VOLUME_TYPE(vec3i(128), vec3f(0.f), vec3f(1.f)));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  // not a multiple of any SIMD width or internal task size
+  const size_t count = 10007;
+
+  std::vector<vec3f> objectCoordinates(count);
+  std::vector<float> objectCoordinatesX(count);
+  std::vector<float> objectCoordinatesY(count);
+  std::vector<float> objectCoordinatesZ(count);
+
+  for (size_t i = 0; i < count; i++) {
+    objectCoordinates[i]  = vec3f(distX(eng), distY(eng), distZ(eng));
+    objectCoordinatesX[i] = objectCoordinates[i].x;
+    objectCoordinatesY[i] = objectCoordinates[i].y;
+    objectCoordinatesZ[i] = objectCoordinates[i].z;
+  }
+
+  std::vector<float> samples(count);
+  std::vector<float> samplesSoA(count);
+
+  vklComputeSampleStream(vklVolume,
+                         count,
+                         (const vkl_vec3f *)objectCoordinates.data(),
+                         samples.data());
+
+  vklComputeSampleStreamSoA(vklVolume,
+                            count,
+                            objectCoordinatesX.data(),
+                            objectCoordinatesY.data(),
+                            objectCoordinatesZ.data(),
+                            samplesSoA.data());
+
+  for (size_t i = 0; i < count; i++) {
+    float sampleTruth = vklComputeSample(
+        vklVolume, (const vkl_vec3f *)&objectCoordinates[i]);
+
+    INFO("sample = " << i + 1 << " / " << count);
+    REQUIRE(sampleTruth == samples[i]);
+    REQUIRE(sampleTruth == samplesSoA[i]);
+  }
+}
+
+TEST_CASE("Stream sampling", "[volume_sampling]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  SECTION("structured")
+  {
+    test_stream_sampling<WaveletProceduralVolume>();
+  }
+
+  SECTION("unstructured")
+  {
+    test_stream_sampling<WaveletUnstructuredProceduralVolume>();
+  }
+}
@@ -95,6 +95,45 @@ void wavelet_scalar_gradients()
   }
 }
 
+void xyz_scalar_sample_and_gradients()
+{
+  const vec3i dimensions(32);
+  const float boundingBoxSize = 32.f;
+
+  std::unique_ptr<XYZProceduralVolume> v(new XYZProceduralVolume(
+      dimensions, vec3f(0.f), boundingBoxSize / vec3f(dimensions)));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  multidim_index_sequence<3> mis(v->getDimensions());
+
+  for (const auto &offset : mis) {
+    const vec3f objectCoordinates =
+        v->getGridOrigin() + offset * v->getGridSpacing();
+
+    INFO("offset = " << offset.x << " " << offset.y << " " << offset.z);
+
+    vkl_vec3f vklGradient;
+    const float sample = vklComputeSampleAndGradient(
+        vklVolume, (const vkl_vec3f *)&objectCoordinates, &vklGradient);
+    const vec3f gradient = (const vec3f &)vklGradient;
+
+    // the sample must match the regular sampling path exactly
+    REQUIRE(sample ==
+            vklComputeSample(vklVolume,
+                             (const vkl_vec3f *)&objectCoordinates));
+
+    // the trilinear interpolant of this volume is exact, so its analytic
+    // gradient should be as well
+    const vec3f proceduralGradient =
+        v->computeProceduralGradient(objectCoordinates);
+
+    REQUIRE(gradient.x == Approx(proceduralGradient.x).epsilon(1e-4f));
+    REQUIRE(gradient.y == Approx(proceduralGradient.y).epsilon(1e-4f));
+    REQUIRE(gradient.z == Approx(proceduralGradient.z).epsilon(1e-4f));
+  }
+}
+
 TEST_CASE("Structured volume gradients", "[volume_gradients]")
 {
   vklLoadModule("ispc_driver");
@@ -112,4 +151,9 @@ TEST_CASE("Structured volume gradients", "[volume_gradients]")
   {
     wavelet_scalar_gradients();
   }
+
+  SECTION("XYZProceduralVolume fused sample and gradient")
+  {
+    xyz_scalar_sample_and_gradients();
+  }
 }
@@ -0,0 +1,290 @@
+// ======================================================================== //
+// Copyright 2019 Intel Corporation                                         //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include <array>
+#include <string>
+#include "../../external/catch.hpp"
+#include "aos_soa_conversion.h"
+#include "openvkl_testing.h"
+
+using namespace ospcommon;
+using namespace openvkl::testing;
+
+// creates a structured volume with one attribute per given volume
+VKLVolume createMultiAttributeVolume(
+    const std::vector<TestingStructuredVolume *> &attributeVolumes)
+{
+  const vec3i dimensions = attributeVolumes[0]->getDimensions();
+
+  std::vector<VKLData> attributes;
+
+  for (auto &v : attributeVolumes) {
+    std::vector<unsigned char> voxels = v->generateVoxels();
+    attributes.push_back(vklNewData(
+        longProduct(dimensions), v->getVoxelType(), voxels.data()));
+  }
+
+  VKLVolume volume = vklNewVolume("structured_regular");
+
+  vklSetVec3i(volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+
+  VKLData voxelData =
+      vklNewData(attributes.size(), VKL_DATA, attributes.data());
+  vklSetData(volume, "voxelData", voxelData);
+  vklRelease(voxelData);
+
+  for (auto &a : attributes)
+    vklRelease(a);
+
+  vklCommit(volume);
+
+  return volume;
+}
+
+// sets the filter of a volume and of the single-attribute volumes it is
+// compared against
+void setFilter(VKLVolume volume,
+               const std::vector<TestingStructuredVolume *> &truth,
+               const std::string &filter)
+{
+  vklSetString(volume, "filter", filter.c_str());
+  vklCommit(volume);
+
+  for (auto &v : truth) {
+    vklSetString(v->getVKLVolume(), "filter", filter.c_str());
+    vklCommit(v->getVKLVolume());
+  }
+}
+
+// by default, requests attributes out of order, with one attribute requested
+// twice
+void scalar_sampling_multi_attribute(
+    VKLVolume volume,
+    const std::vector<TestingStructuredVolume *> &truth,
+    const std::vector<unsigned int> &attributeIndices = {2, 0, 1, 2},
+    float margin = 0.f)
+{
+
+  vkl_box3f bbox = vklGetBoundingBox(volume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  for (size_t i = 0; i < 1000; i++) {
+    const vec3f oc(distX(eng), distY(eng), distZ(eng));
+
+    std::vector<float> samples(attributeIndices.size());
+
+    vklComputeSampleM(volume,
+                      (const vkl_vec3f *)&oc,
+                      samples.data(),
+                      attributeIndices.size(),
+                      attributeIndices.data());
+
+    INFO("objectCoordinates = " << oc.x << " " << oc.y << " " << oc.z);
+
+    for (size_t a = 0; a < attributeIndices.size(); a++) {
+      const float sampleTruth = vklComputeSample(
+          truth[attributeIndices[a]]->getVKLVolume(), (const vkl_vec3f *)&oc);
+
+      INFO("attribute index = " << attributeIndices[a]);
+      REQUIRE(samples[a] == Approx(sampleTruth).margin(margin));
+    }
+
+    // the first attribute is also used for single-attribute sampling
+    const float sample = vklComputeSample(volume, (const vkl_vec3f *)&oc);
+
+    for (size_t a = 0; a < attributeIndices.size(); a++) {
+      if (attributeIndices[a] == 0)
+        REQUIRE(sample == Approx(samples[a]).margin(margin));
+    }
+  }
+}
+
+void vectorized_sampling_multi_attribute(
+    VKLVolume volume,
+    const std::vector<unsigned int> &attributeIndices = {1, 2, 0})
+{
+  const unsigned int M = attributeIndices.size();
+
+  vkl_box3f bbox = vklGetBoundingBox(volume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  const int maxWidth = 16;
+
+  std::array<int, 3> nativeWidths{4, 8, 16};
+
+  for (int width = 1; width < maxWidth; width++) {
+    std::vector<vec3f> objectCoordinates(width);
+    for (auto &oc : objectCoordinates) {
+      oc = vec3f(distX(eng), distY(eng), distZ(eng));
+    }
+
+    for (auto callingWidth : nativeWidths) {
+      if (width > callingWidth) {
+        continue;
+      }
+
+      std::vector<int> valid(callingWidth, 0);
+      std::fill(valid.begin(), valid.begin() + width, 1);
+
+      std::vector<float> objectCoordinatesSOA =
+          AOStoSOA_vec3f(objectCoordinates, callingWidth);
+
+      std::vector<float> samples(M * callingWidth);
+
+      if (callingWidth == 4) {
+        vklComputeSampleM4(valid.data(),
+                           volume,
+                           (const vkl_vvec3f4 *)objectCoordinatesSOA.data(),
+                           samples.data(),
+                           M,
+                           attributeIndices.data());
+      } else if (callingWidth == 8) {
+        vklComputeSampleM8(valid.data(),
+                           volume,
+                           (const vkl_vvec3f8 *)objectCoordinatesSOA.data(),
+                           samples.data(),
+                           M,
+                           attributeIndices.data());
+      } else if (callingWidth == 16) {
+        vklComputeSampleM16(valid.data(),
+                            volume,
+                            (const vkl_vvec3f16 *)objectCoordinatesSOA.data(),
+                            samples.data(),
+                            M,
+                            attributeIndices.data());
+      } else {
+        throw std::runtime_error("unsupported calling width");
+      }
+
+      for (int i = 0; i < width; i++) {
+        std::vector<float> samplesTruth(M);
+
+        vklComputeSampleM(volume,
+                          (const vkl_vec3f *)&objectCoordinates[i],
+                          samplesTruth.data(),
+                          M,
+                          attributeIndices.data());
+
+        for (unsigned int a = 0; a < M; a++) {
+          INFO("sample = " << i + 1 << " / " << width
+                           << ", calling width = " << callingWidth
+                           << ", attribute = " << a);
+          REQUIRE(samplesTruth[a] == samples[a * callingWidth + i]);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Structured volume multi-attribute sampling", "[volume_sampling]")
+{
+  vklLoadModule("ispc_driver");
+
+  VKLDriver driver = vklNewDriver("ispc");
+  vklCommitDriver(driver);
+  vklSetCurrentDriver(driver);
+
+  const vec3i dimensions(67, 43, 29);
+
+  std::unique_ptr<WaveletProceduralVolumeFloat> v0(
+      new WaveletProceduralVolumeFloat(dimensions, vec3f(0.f), vec3f(1.f)));
+  std::unique_ptr<ZProceduralVolume> v1(
+      new ZProceduralVolume(dimensions, vec3f(0.f), vec3f(1.f)));
+  std::unique_ptr<WaveletProceduralVolumeUchar> v2(
+      new WaveletProceduralVolumeUchar(dimensions, vec3f(0.f), vec3f(1.f)));
+
+  const std::vector<TestingStructuredVolume *> truth{
+      v0.get(), v1.get(), v2.get()};
+
+  VKLVolume volume = createMultiAttributeVolume(truth);
+
+  REQUIRE(vklGetNumAttributes(volume) == 3);
+  REQUIRE(vklGetNumAttributes(v0->getVKLVolume()) == 1);
+
+  SECTION("linear layout")
+  {
+    scalar_sampling_multi_attribute(volume, truth);
+    vectorized_sampling_multi_attribute(volume);
+  }
+
+  SECTION("bricked layout")
+  {
+    vklSetString(volume, "layout", "bricked");
+    vklCommit(volume);
+
+    scalar_sampling_multi_attribute(volume, truth);
+    vectorized_sampling_multi_attribute(volume);
+  }
+
+  SECTION("nearest filter")
+  {
+    setFilter(volume, truth, "nearest");
+
+    scalar_sampling_multi_attribute(volume, truth);
+    vectorized_sampling_multi_attribute(volume);
+  }
+
+  SECTION("nearest filter, bricked layout")
+  {
+    vklSetString(volume, "layout", "bricked");
+    setFilter(volume, truth, "nearest");
+
+    scalar_sampling_multi_attribute(volume, truth);
+    vectorized_sampling_multi_attribute(volume);
+  }
+
+  SECTION("tricubic filter")
+  {
+    setFilter(volume, truth, "tricubic");
+
+    // the eight trilinear taps are summed in a different order
+    scalar_sampling_multi_attribute(volume, truth, {2, 0, 1, 2}, 1e-4f);
+    vectorized_sampling_multi_attribute(volume);
+  }
+
+  SECTION("compressed layout")
+  {
+    // compressed volumes have a single attribute, which may be requested
+    // repeatedly
+    std::unique_ptr<WaveletProceduralVolumeFloat> vCompressed(
+        new WaveletProceduralVolumeFloat(dimensions,
+                                         vec3f(0.f),
+                                         vec3f(1.f),
+                                         "structured_regular_compressed"));
+
+    VKLVolume vklVolumeCompressed = vCompressed->getVKLVolume();
+
+    REQUIRE(vklGetNumAttributes(vklVolumeCompressed) == 1);
+
+    scalar_sampling_multi_attribute(
+        vklVolumeCompressed, {vCompressed.get()}, {0, 0});
+    vectorized_sampling_multi_attribute(vklVolumeCompressed, {0, 0});
+  }
+
+  vklRelease(volume);
+}
@@ -14,6 +14,9 @@
 // limitations under the License.                                           //
 // ======================================================================== //
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "../../external/catch.hpp"
 #include "openvkl_testing.h"
 #include "ospcommon/utility/multidim_index_sequence.h"
@@ -51,6 +54,599 @@ void scalar_sampling_on_vertices_vs_procedural_values(vec3i dimensions,
   }
 }
 
+template <typename VOXEL_TYPE>
+void scalar_sampling_bricked_vs_linear_layout(vec3i dimensions)
+{
+  std::unique_ptr<
+      ProceduralStructuredVolume<VOXEL_TYPE, getWaveletValue<VOXEL_TYPE>>>
+      v(new ProceduralStructuredVolume<VOXEL_TYPE, getWaveletValue<VOXEL_TYPE>>(
+          dimensions, vec3f(0.f), vec3f(1.f)));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  const size_t numSamples = 1000;
+
+  std::vector<vec3f> objectCoordinates(numSamples);
+  std::vector<float> linearSamples(numSamples);
+
+  for (size_t i = 0; i < numSamples; i++) {
+    objectCoordinates[i] = vec3f(distX(eng), distY(eng), distZ(eng));
+    linearSamples[i]     = vklComputeSample(
+        vklVolume, (const vkl_vec3f *)&objectCoordinates[i]);
+  }
+
+  vklSetString(vklVolume, "layout", "bricked");
+  vklCommit(vklVolume);
+
+  for (size_t i = 0; i < numSamples; i++) {
+    INFO("objectCoordinates = " << objectCoordinates[i].x << " "
+                                << objectCoordinates[i].y << " "
+                                << objectCoordinates[i].z);
+    REQUIRE(vklComputeSample(vklVolume,
+                             (const vkl_vec3f *)&objectCoordinates[i]) ==
+            linearSamples[i]);
+  }
+}
+
+template <typename VOXEL_TYPE>
+void scalar_sampling_compressed_vs_linear_layout(vec3i dimensions,
+                                                 int bitsPerVoxel)
+{
+  using Volume =
+      ProceduralStructuredVolume<VOXEL_TYPE, getWaveletValue<VOXEL_TYPE>>;
+
+  std::unique_ptr<Volume> v(new Volume(dimensions, vec3f(0.f), vec3f(1.f)));
+
+  std::unique_ptr<Volume> vCompressed(new Volume(
+      dimensions, vec3f(0.f), vec3f(1.f), "structured_regular_compressed"));
+
+  VKLVolume vklVolume           = v->getVKLVolume();
+  VKLVolume vklVolumeCompressed = vCompressed->getVKLVolume();
+
+  // the full precision voxelData is released once compressed, so it must be
+  // set again to recompress with a different bitsPerVoxel
+  const std::vector<unsigned char> voxels = v->generateVoxels();
+
+  VKLData voxelData = vklNewData(
+      longProduct(dimensions), vCompressed->getVoxelType(), voxels.data());
+  vklSetData(vklVolumeCompressed, "voxelData", voxelData);
+  vklRelease(voxelData);
+
+  vklSetInt(vklVolumeCompressed, "bitsPerVoxel", bitsPerVoxel);
+  vklCommit(vklVolumeCompressed);
+
+  // later commits without voxelData reuse the compressed bricks
+  vklSetString(vklVolumeCompressed, "hitMethod", "exact");
+  vklCommit(vklVolumeCompressed);
+
+  // the quantization error of each brick is bounded by half a quantization
+  // step of the brick value range, which in turn is bounded by the global
+  // value range
+  const VOXEL_TYPE *voxelsTyped = (const VOXEL_TYPE *)voxels.data();
+
+  const auto minMax = std::minmax_element(
+      voxelsTyped, voxelsTyped + longProduct(dimensions));
+
+  const float valueRange = float(*minMax.second) - float(*minMax.first);
+  const float tolerance =
+      0.5f * valueRange / float((1 << bitsPerVoxel) - 1) + 1e-4f;
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  const size_t numSamples = 1000;
+
+  for (size_t i = 0; i < numSamples; i++) {
+    const vec3f objectCoordinates(distX(eng), distY(eng), distZ(eng));
+
+    INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                << objectCoordinates.y << " "
+                                << objectCoordinates.z);
+    REQUIRE(vklComputeSample(vklVolumeCompressed,
+                             (const vkl_vec3f *)&objectCoordinates) ==
+            Approx(vklComputeSample(vklVolume,
+                                    (const vkl_vec3f *)&objectCoordinates))
+                .margin(tolerance));
+  }
+}
+
+void scalar_sampling_compressed_non_finite_voxels()
+{
+  const vec3i dimensions(16);
+
+  std::vector<float> voxels(longProduct(dimensions));
+
+  for (int z = 0; z < dimensions.z; z++) {
+    for (int y = 0; y < dimensions.y; y++) {
+      for (int x = 0; x < dimensions.x; x++) {
+        float &voxel = voxels[(z * dimensions.y + y) * dimensions.x + x];
+
+        // the brick at (0, 1, 0) has no finite voxels at all
+        if (x < 8 && y >= 8 && z < 8) {
+          voxel = std::numeric_limits<float>::quiet_NaN();
+        } else {
+          voxel = float(x + y + z);
+        }
+      }
+    }
+  }
+
+  voxels[(1 * dimensions.y + 1) * dimensions.x + 1] =
+      std::numeric_limits<float>::quiet_NaN();
+  voxels[(10 * dimensions.y + 10) * dimensions.x + 10] =
+      std::numeric_limits<float>::infinity();
+
+  VKLVolume volume = vklNewVolume("structured_regular_compressed");
+
+  vklSetVec3i(volume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+  vklSetVec3f(volume, "gridOrigin", 0.f, 0.f, 0.f);
+  vklSetVec3f(volume, "gridSpacing", 1.f, 1.f, 1.f);
+
+  VKLData voxelData = vklNewData(voxels.size(), VKL_FLOAT, voxels.data());
+  vklSetData(volume, "voxelData", voxelData);
+  vklRelease(voxelData);
+
+  vklCommit(volume);
+
+  // non-finite voxels do not affect the value range of their brick, so that
+  // all samples remain finite, and bricks without them keep their precision
+  const float tolerance = 0.5f * 21.f / 255.f + 1e-4f;
+
+  multidim_index_sequence<3> mis(dimensions);
+
+  for (const auto &offset : mis) {
+    const vec3f objectCoordinates(offset);
+
+    INFO("offset = " << offset.x << " " << offset.y << " " << offset.z);
+
+    const float sample =
+        vklComputeSample(volume, (const vkl_vec3f *)&objectCoordinates);
+
+    REQUIRE(std::isfinite(sample));
+
+    if (offset.x >= 8 && offset.y < 8 && offset.z < 8) {
+      REQUIRE(sample ==
+              Approx(offset.x + offset.y + offset.z).margin(tolerance));
+    }
+  }
+
+  vklRelease(volume);
+}
+
+void scalar_sampling_nearest_filter(vec3i dimensions)
+{
+  std::unique_ptr<WaveletProceduralVolume> v(
+      new WaveletProceduralVolume(dimensions, vec3f(0.f), vec3f(1.f)));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vklSetString(vklVolume, "filter", "nearest");
+  vklCommit(vklVolume);
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  for (size_t i = 0; i < 1000; i++) {
+    const vec3f objectCoordinates(distX(eng), distY(eng), distZ(eng));
+
+    // grid origin is zero and spacing is one, so the nearest voxel is at the
+    // rounded object coordinates
+    const vec3f nearestVoxel(std::round(objectCoordinates.x),
+                             std::round(objectCoordinates.y),
+                             std::round(objectCoordinates.z));
+
+    INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                << objectCoordinates.y << " "
+                                << objectCoordinates.z);
+    REQUIRE(
+        vklComputeSample(vklVolume, (const vkl_vec3f *)&objectCoordinates) ==
+        Approx(v->computeProceduralValue(nearestVoxel)).margin(1e-4f));
+  }
+}
+
+void scalar_sampling_tricubic_filter(vec3i dimensions,
+                                     vec3f gridOrigin,
+                                     vec3f gridSpacing)
+{
+  std::unique_ptr<XYZProceduralVolume> v(
+      new XYZProceduralVolume(dimensions, gridOrigin, gridSpacing));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vklSetString(vklVolume, "filter", "tricubic");
+  vklCommit(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  // cubic B-splines reproduce (multi)linear fields exactly, as long as the
+  // 4^3 neighborhood doesn't extend past the volume boundary
+  const vec3f innerLower = gridOrigin + gridSpacing;
+  const vec3f innerUpper = gridOrigin + gridSpacing * vec3f(dimensions - 2);
+
+  std::uniform_real_distribution<float> distX(innerLower.x, innerUpper.x);
+  std::uniform_real_distribution<float> distY(innerLower.y, innerUpper.y);
+  std::uniform_real_distribution<float> distZ(innerLower.z, innerUpper.z);
+
+  for (size_t i = 0; i < 1000; i++) {
+    const vec3f objectCoordinates(distX(eng), distY(eng), distZ(eng));
+
+    INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                << objectCoordinates.y << " "
+                                << objectCoordinates.z);
+    REQUIRE(
+        vklComputeSample(vklVolume, (const vkl_vec3f *)&objectCoordinates) ==
+        Approx(v->computeProceduralValue(objectCoordinates))
+            .epsilon(1e-4f)
+            .margin(1e-2f));
+  }
+
+  // neighborhoods clamped at the volume boundary still yield valid samples
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::uniform_real_distribution<float> distBoundsX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distBoundsY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distBoundsZ(bbox.lower.z, bbox.upper.z);
+
+  for (size_t i = 0; i < 1000; i++) {
+    const vec3f objectCoordinates(
+        distBoundsX(eng), distBoundsY(eng), distBoundsZ(eng));
+
+    INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                << objectCoordinates.y << " "
+                                << objectCoordinates.z);
+    REQUIRE(!std::isnan(
+        vklComputeSample(vklVolume, (const vkl_vec3f *)&objectCoordinates)));
+  }
+}
+
+// graded per-axis coordinates, with cells growing quadratically along each axis
+std::vector<float> gradedCoordinates(int numVertices, float lower, float upper)
+{
+  std::vector<float> coordinates(numVertices);
+
+  for (int i = 0; i < numVertices; i++) {
+    const float t  = float(i) / float(numVertices - 1);
+    coordinates[i] = lower + (upper - lower) * t * t;
+  }
+
+  return coordinates;
+}
+
+void scalar_sampling_rectilinear_grid(vec3i dimensions)
+{
+  const std::vector<float> coordinates[3] = {
+      gradedCoordinates(dimensions.x, -1.f, 2.f),
+      gradedCoordinates(dimensions.y, 0.5f, 1.5f),
+      gradedCoordinates(dimensions.z, -3.f, 0.f)};
+
+  // x*y*z is linear along each axis, so trilinear interpolation over the
+  // rectilinear grid reproduces it exactly
+  std::vector<float> voxels(longProduct(dimensions));
+
+  for (int z = 0; z < dimensions.z; z++)
+    for (int y = 0; y < dimensions.y; y++)
+      for (int x = 0; x < dimensions.x; x++)
+        voxels[(size_t(z) * dimensions.y + y) * dimensions.x + x] = getXYZValue(
+            vec3f(coordinates[0][x], coordinates[1][y], coordinates[2][z]));
+
+  VKLVolume vklVolume = vklNewVolume("structured_rectilinear");
+
+  vklSetVec3i(
+      vklVolume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+
+  const char *coordinateNames[3] = {
+      "xCoordinates", "yCoordinates", "zCoordinates"};
+
+  for (int i = 0; i < 3; i++) {
+    VKLData data =
+        vklNewData(coordinates[i].size(), VKL_FLOAT, coordinates[i].data());
+    vklSetData(vklVolume, coordinateNames[i], data);
+    vklRelease(data);
+  }
+
+  VKLData voxelData = vklNewData(voxels.size(), VKL_FLOAT, voxels.data());
+  vklSetData(vklVolume, "voxelData", voxelData);
+  vklRelease(voxelData);
+
+  vklCommit(vklVolume);
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  REQUIRE(bbox.lower.x == -1.f);
+  REQUIRE(bbox.lower.y == 0.5f);
+  REQUIRE(bbox.lower.z == -3.f);
+  REQUIRE(bbox.upper.x == 2.f);
+  REQUIRE(bbox.upper.y == 1.5f);
+  REQUIRE(bbox.upper.z == 0.f);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  for (size_t i = 0; i < 1000; i++) {
+    const vec3f objectCoordinates(distX(eng), distY(eng), distZ(eng));
+
+    INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                << objectCoordinates.y << " "
+                                << objectCoordinates.z);
+
+    vec3f gradient;
+    const float sample =
+        vklComputeSampleAndGradient(vklVolume,
+                                    (const vkl_vec3f *)&objectCoordinates,
+                                    (vkl_vec3f *)&gradient);
+
+    const vec3f expectedGradient = getXYZGradient(objectCoordinates);
+
+    REQUIRE(sample == Approx(getXYZValue(objectCoordinates))
+                          .epsilon(1e-4f)
+                          .margin(1e-4f));
+    REQUIRE(gradient.x == Approx(expectedGradient.x).margin(1e-3f));
+    REQUIRE(gradient.y == Approx(expectedGradient.y).margin(1e-3f));
+    REQUIRE(gradient.z == Approx(expectedGradient.z).margin(1e-3f));
+  }
+
+  vklRelease(vklVolume);
+}
+
+void scalar_sampling_spherical_grid()
+{
+  // full sphere of radius 1, with 10 degree angular spacing
+  const vec3i dimensions(32, 19, 37);
+  const vec3f gridOrigin(0.f);
+  const vec3f gridSpacing(1.f / 31.f, 10.f, 10.f);
+
+  // the voxel values are the radius, which is linear in the radial dimension
+  // and thus reproduced exactly by trilinear interpolation
+  std::vector<float> voxels(longProduct(dimensions));
+
+  for (int z = 0; z < dimensions.z; z++)
+    for (int y = 0; y < dimensions.y; y++)
+      for (int x = 0; x < dimensions.x; x++)
+        voxels[(size_t(z) * dimensions.y + y) * dimensions.x + x] =
+            x * gridSpacing.x;
+
+  VKLVolume vklVolume = vklNewVolume("structured_spherical");
+
+  vklSetVec3i(
+      vklVolume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+  vklSetVec3f(
+      vklVolume, "gridOrigin", gridOrigin.x, gridOrigin.y, gridOrigin.z);
+  vklSetVec3f(
+      vklVolume, "gridSpacing", gridSpacing.x, gridSpacing.y, gridSpacing.z);
+
+  VKLData voxelData = vklNewData(voxels.size(), VKL_FLOAT, voxels.data());
+  vklSetData(vklVolume, "voxelData", voxelData);
+  vklRelease(voxelData);
+
+  vklCommit(vklVolume);
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  REQUIRE(bbox.lower.x == Approx(-1.f));
+  REQUIRE(bbox.lower.y == Approx(-1.f));
+  REQUIRE(bbox.lower.z == Approx(-1.f));
+  REQUIRE(bbox.upper.x == Approx(1.f));
+  REQUIRE(bbox.upper.y == Approx(1.f));
+  REQUIRE(bbox.upper.z == Approx(1.f));
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+  size_t numSamples = 0;
+
+  while (numSamples < 1000) {
+    const vec3f objectCoordinates(dist(eng), dist(eng), dist(eng));
+
+    const float radius = length(objectCoordinates);
+
+    // stay clear of the outer boundary and of the z axis, where the angular
+    // derivatives are singular
+    if (radius > 0.99f ||
+        std::sqrt(objectCoordinates.x * objectCoordinates.x +
+                  objectCoordinates.y * objectCoordinates.y) < 0.05f) {
+      continue;
+    }
+
+    INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                << objectCoordinates.y << " "
+                                << objectCoordinates.z);
+
+    vec3f gradient;
+    const float sample =
+        vklComputeSampleAndGradient(vklVolume,
+                                    (const vkl_vec3f *)&objectCoordinates,
+                                    (vkl_vec3f *)&gradient);
+
+    const vec3f expectedGradient = objectCoordinates / radius;
+
+    REQUIRE(sample == Approx(radius).margin(1e-4f));
+    REQUIRE(gradient.x == Approx(expectedGradient.x).margin(1e-3f));
+    REQUIRE(gradient.y == Approx(expectedGradient.y).margin(1e-3f));
+    REQUIRE(gradient.z == Approx(expectedGradient.z).margin(1e-3f));
+
+    numSamples++;
+  }
+
+  vklRelease(vklVolume);
+}
+
+// local coordinate of c along an axis of a rectilinear grid with the given
+// vertex coordinates
+float rectilinearLocalCoordinate(const std::vector<float> &coordinates, float c)
+{
+  // index of the cell containing c, within [0, coordinates.size() - 2]
+  const size_t i =
+      std::upper_bound(coordinates.begin(), coordinates.end() - 1, c) -
+      coordinates.begin() - 1;
+
+  return i + (c - coordinates[i]) / (coordinates[i + 1] - coordinates[i]);
+}
+
+void scalar_sampling_tricubic_rectilinear_grid(vec3i dimensions)
+{
+  const std::vector<float> coordinates[3] = {
+      gradedCoordinates(dimensions.x, -1.f, 2.f),
+      gradedCoordinates(dimensions.y, 0.5f, 1.5f),
+      gradedCoordinates(dimensions.z, -3.f, 0.f)};
+
+  // the voxel values are linear in the voxel indices, so the tricubic filter
+  // reproduces them exactly away from the boundary
+  std::vector<float> voxels(longProduct(dimensions));
+
+  for (int z = 0; z < dimensions.z; z++)
+    for (int y = 0; y < dimensions.y; y++)
+      for (int x = 0; x < dimensions.x; x++)
+        voxels[(size_t(z) * dimensions.y + y) * dimensions.x + x] =
+            x + 2.f * y + 3.f * z;
+
+  VKLVolume vklVolume = vklNewVolume("structured_rectilinear");
+
+  vklSetVec3i(
+      vklVolume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+
+  const char *coordinateNames[3] = {
+      "xCoordinates", "yCoordinates", "zCoordinates"};
+
+  for (int i = 0; i < 3; i++) {
+    VKLData data =
+        vklNewData(coordinates[i].size(), VKL_FLOAT, coordinates[i].data());
+    vklSetData(vklVolume, coordinateNames[i], data);
+    vklRelease(data);
+  }
+
+  VKLData voxelData = vklNewData(voxels.size(), VKL_FLOAT, voxels.data());
+  vklSetData(vklVolume, "voxelData", voxelData);
+  vklRelease(voxelData);
+
+  vklSetString(vklVolume, "filter", "tricubic");
+  vklCommit(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(coordinates[0][1],
+                                              coordinates[0][dimensions.x - 2]);
+  std::uniform_real_distribution<float> distY(coordinates[1][1],
+                                              coordinates[1][dimensions.y - 2]);
+  std::uniform_real_distribution<float> distZ(coordinates[2][1],
+                                              coordinates[2][dimensions.z - 2]);
+
+  for (size_t i = 0; i < 1000; i++) {
+    const vec3f objectCoordinates(distX(eng), distY(eng), distZ(eng));
+
+    const float expected =
+        rectilinearLocalCoordinate(coordinates[0], objectCoordinates.x) +
+        2.f * rectilinearLocalCoordinate(coordinates[1], objectCoordinates.y) +
+        3.f * rectilinearLocalCoordinate(coordinates[2], objectCoordinates.z);
+
+    INFO("objectCoordinates = " << objectCoordinates.x << " "
+                                << objectCoordinates.y << " "
+                                << objectCoordinates.z);
+    REQUIRE(
+        vklComputeSample(vklVolume, (const vkl_vec3f *)&objectCoordinates) ==
+        Approx(expected).margin(1e-3f));
+  }
+
+  vklRelease(vklVolume);
+}
+
+void scalar_sampling_tricubic_spherical_grid()
+{
+  // full sphere of radius 1, with 10 degree angular spacing
+  const vec3i dimensions(32, 19, 37);
+  const vec3f gridSpacing(1.f / 31.f, 10.f, 10.f);
+
+  // the voxel values are linear in the voxel indices, so the tricubic filter
+  // reproduces them exactly away from the boundary, including the neighborhoods
+  // touching the last azimuth at 360 degrees
+  std::vector<float> voxels(longProduct(dimensions));
+
+  for (int z = 0; z < dimensions.z; z++)
+    for (int y = 0; y < dimensions.y; y++)
+      for (int x = 0; x < dimensions.x; x++)
+        voxels[(size_t(z) * dimensions.y + y) * dimensions.x + x] =
+            x + 2.f * y + 3.f * z;
+
+  VKLVolume vklVolume = vklNewVolume("structured_spherical");
+
+  vklSetVec3i(
+      vklVolume, "dimensions", dimensions.x, dimensions.y, dimensions.z);
+  vklSetVec3f(vklVolume, "gridOrigin", 0.f, 0.f, 0.f);
+  vklSetVec3f(
+      vklVolume, "gridSpacing", gridSpacing.x, gridSpacing.y, gridSpacing.z);
+
+  VKLData voxelData = vklNewData(voxels.size(), VKL_FLOAT, voxels.data());
+  vklSetData(vklVolume, "voxelData", voxelData);
+  vklRelease(voxelData);
+
+  vklSetString(vklVolume, "filter", "tricubic");
+  vklCommit(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  const float degreesToRadians = std::acos(-1.f) / 180.f;
+
+  // local coordinates in [1, dimensions - 2]
+  std::uniform_real_distribution<float> distRadius(1.f / 31.f, 30.f / 31.f);
+  std::uniform_real_distribution<float> distInclination(10.f, 170.f);
+  std::uniform_real_distribution<float> distAzimuth(10.f, 350.f);
+
+  for (size_t i = 0; i < 1000; i++) {
+    const float radius      = distRadius(eng);
+    const float inclination = distInclination(eng);
+    const float azimuth     = distAzimuth(eng);
+
+    const float inclinationRadians = inclination * degreesToRadians;
+    const float azimuthRadians     = azimuth * degreesToRadians;
+
+    const vec3f objectCoordinates =
+        radius * vec3f(std::sin(inclinationRadians) * std::cos(azimuthRadians),
+                       std::sin(inclinationRadians) * std::sin(azimuthRadians),
+                       std::cos(inclinationRadians));
+
+    const float expected = radius / gridSpacing.x +
+                           2.f * inclination / gridSpacing.y +
+                           3.f * azimuth / gridSpacing.z;
+
+    INFO("radius = " << radius << ", inclination = " << inclination
+                     << ", azimuth = " << azimuth);
+    REQUIRE(
+        vklComputeSample(vklVolume, (const vkl_vec3f *)&objectCoordinates) ==
+        Approx(expected).margin(1e-2f));
+  }
+
+  vklRelease(vklVolume);
+}
+
 TEST_CASE("Structured volume sampling", "[volume_sampling]")
 {
   vklLoadModule("ispc_driver");
@@ -87,6 +683,130 @@ TEST_CASE("Structured volume sampling", "[volume_sampling]")
     {
       scalar_sampling_on_vertices_vs_procedural_values<double>(vec3i(128));
     }
+
+    SECTION("half")
+    {
+      scalar_sampling_on_vertices_vs_procedural_values<half_float>(
+          vec3i(128));
+    }
+
+    SECTION("bfloat16")
+    {
+      scalar_sampling_on_vertices_vs_procedural_values<bfloat16>(vec3i(128));
+    }
+  }
+
+  // dimensions are deliberately not multiples of the brick width
+  SECTION("bricked layout")
+  {
+    SECTION("unsigned char")
+    {
+      scalar_sampling_bricked_vs_linear_layout<unsigned char>(
+          vec3i(67, 43, 29));
+    }
+
+    SECTION("short")
+    {
+      scalar_sampling_bricked_vs_linear_layout<short>(vec3i(67, 43, 29));
+    }
+
+    SECTION("unsigned short")
+    {
+      scalar_sampling_bricked_vs_linear_layout<unsigned short>(
+          vec3i(67, 43, 29));
+    }
+
+    SECTION("float")
+    {
+      scalar_sampling_bricked_vs_linear_layout<float>(vec3i(67, 43, 29));
+    }
+
+    SECTION("double")
+    {
+      scalar_sampling_bricked_vs_linear_layout<double>(vec3i(67, 43, 29));
+    }
+
+    SECTION("half")
+    {
+      scalar_sampling_bricked_vs_linear_layout<half_float>(vec3i(67, 43, 29));
+    }
+
+    SECTION("bfloat16")
+    {
+      scalar_sampling_bricked_vs_linear_layout<bfloat16>(vec3i(67, 43, 29));
+    }
+  }
+
+  SECTION("compressed layout")
+  {
+    SECTION("unsigned char, 8 bits per voxel")
+    {
+      scalar_sampling_compressed_vs_linear_layout<unsigned char>(
+          vec3i(67, 43, 29), 8);
+    }
+
+    SECTION("float, 8 bits per voxel")
+    {
+      scalar_sampling_compressed_vs_linear_layout<float>(vec3i(67, 43, 29),
+                                                         8);
+    }
+
+    SECTION("float, 16 bits per voxel")
+    {
+      scalar_sampling_compressed_vs_linear_layout<float>(vec3i(67, 43, 29),
+                                                         16);
+    }
+
+    SECTION("double, 16 bits per voxel")
+    {
+      scalar_sampling_compressed_vs_linear_layout<double>(vec3i(67, 43, 29),
+                                                          16);
+    }
+
+    SECTION("non-finite voxels")
+    {
+      scalar_sampling_compressed_non_finite_voxels();
+    }
+  }
+
+  SECTION("filters")
+  {
+    SECTION("nearest")
+    {
+      scalar_sampling_nearest_filter(vec3i(67, 43, 29));
+    }
+
+    SECTION("tricubic")
+    {
+      scalar_sampling_tricubic_filter(
+          vec3i(67, 43, 29), vec3f(0.f), vec3f(1.f));
+    }
+
+    SECTION("tricubic, non-zero origin and non-unit spacing")
+    {
+      scalar_sampling_tricubic_filter(
+          vec3i(67, 43, 29), vec3f(-2.f, 1.5f, 0.25f), vec3f(0.5f, 1.25f, 2.f));
+    }
+
+    SECTION("tricubic, rectilinear grid")
+    {
+      scalar_sampling_tricubic_rectilinear_grid(vec3i(33, 17, 25));
+    }
+
+    SECTION("tricubic, spherical grid")
+    {
+      scalar_sampling_tricubic_spherical_grid();
+    }
+  }
+
+  SECTION("rectilinear grid")
+  {
+    scalar_sampling_rectilinear_grid(vec3i(67, 43, 29));
+  }
+
+  SECTION("spherical grid")
+  {
+    scalar_sampling_spherical_grid();
   }
 
   // these are necessarily longer-running tests, so should maybe be split out
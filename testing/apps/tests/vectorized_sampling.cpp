@@ -23,14 +23,8 @@
 using namespace ospcommon;
 using namespace openvkl::testing;
 
-template <typename VOLUME_TYPE>
-void test_vectorized_sampling()
+void test_vectorized_sampling(VKLVolume vklVolume)
 {
-  std::unique_ptr<VOLUME_TYPE> v(
-      new VOLUME_TYPE(vec3i(128), vec3f(0.f), vec3f(1.f)));
-
-  VKLVolume vklVolume = v->getVKLVolume();
-
   SECTION("randomized vectorized sampling varying calling width and masks")
   {
     vkl_box3f bbox = vklGetBoundingBox(vklVolume);
@@ -98,6 +92,59 @@ void test_vectorized_sampling()
   }
 }
 
+template <typename VOLUME_TYPE>
+void test_vectorized_sampling(const char *bvhTraversal = nullptr)
+{
+  std::unique_ptr<VOLUME_TYPE> v(
+      new VOLUME_TYPE(vec3i(128), vec3f(0.f), vec3f(1.f)));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  if (bvhTraversal) {
+    vklSetString(vklVolume, "bvhTraversal", bvhTraversal);
+    vklCommit(vklVolume);
+  }
+
+  test_vectorized_sampling(vklVolume);
+}
+
+void test_vectorized_sampling_structured_filter(const char *filter)
+{
+  std::unique_ptr<WaveletProceduralVolume> v(
+      new WaveletProceduralVolume(vec3i(128), vec3f(0.f), vec3f(1.f)));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vklSetString(vklVolume, "filter", filter);
+  vklCommit(vklVolume);
+
+  test_vectorized_sampling(vklVolume);
+}
+
+void test_vectorized_sampling_structured_compressed()
+{
+  std::unique_ptr<WaveletProceduralVolume> v(
+      new WaveletProceduralVolume(vec3i(128),
+                                  vec3f(0.f),
+                                  vec3f(1.f),
+                                  "structured_regular_compressed"));
+
+  test_vectorized_sampling(v->getVKLVolume());
+}
+
+void test_vectorized_sampling_amr(VKLAMRMethod method)
+{
+  std::unique_ptr<ProceduralShellsAMRVolume<>> v(
+      new ProceduralShellsAMRVolume<>(vec3i(128), vec3f(0.f), vec3f(1.f)));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vklSetInt(vklVolume, "method", method);
+  vklCommit(vklVolume);
+
+  test_vectorized_sampling(vklVolume);
+}
+
 TEST_CASE("Vectorized sampling", "[volume_sampling]")
 {
   vklLoadModule("ispc_driver");
@@ -111,8 +158,48 @@ TEST_CASE("Vectorized sampling", "[volume_sampling]")
     test_vectorized_sampling<WaveletProceduralVolume>();
   }
 
+  SECTION("structured nearest filter")
+  {
+    test_vectorized_sampling_structured_filter("nearest");
+  }
+
+  SECTION("structured tricubic filter")
+  {
+    test_vectorized_sampling_structured_filter("tricubic");
+  }
+
+  SECTION("structured compressed")
+  {
+    test_vectorized_sampling_structured_compressed();
+  }
+
   SECTION("unstructured")
   {
     test_vectorized_sampling<WaveletUnstructuredProceduralVolume>();
   }
+
+  SECTION("unstructured packet BVH traversal")
+  {
+    test_vectorized_sampling<WaveletUnstructuredProceduralVolume>("packet");
+  }
+
+  SECTION("unstructured per-lane BVH traversal")
+  {
+    test_vectorized_sampling<WaveletUnstructuredProceduralVolume>("lane");
+  }
+
+  SECTION("AMR current method")
+  {
+    test_vectorized_sampling_amr(VKL_AMR_CURRENT);
+  }
+
+  SECTION("AMR finest method")
+  {
+    test_vectorized_sampling_amr(VKL_AMR_FINEST);
+  }
+
+  SECTION("AMR octant method")
+  {
+    test_vectorized_sampling_amr(VKL_AMR_OCTANT);
+  }
 }
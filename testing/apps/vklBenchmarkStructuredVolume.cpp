@@ -15,6 +15,7 @@
 // ======================================================================== //
 
 #include <random>
+#include <string>
 #include "../common/simd.h"
 #include "benchmark/benchmark.h"
 #include "openvkl_testing.h"
@@ -123,6 +124,413 @@ BENCHMARK_TEMPLATE(vectorRandomSample, 4);
 BENCHMARK_TEMPLATE(vectorRandomSample, 8);
 BENCHMARK_TEMPLATE(vectorRandomSample, 16);
 
+// vector sampling with each supported filter; state.range(0) selects the
+// filter
+template <int W>
+void vectorRandomSampleFilter(benchmark::State &state)
+{
+  const char *filters[] = {"nearest", "trilinear", "tricubic"};
+
+  std::unique_ptr<WaveletProceduralVolume> v(
+      new WaveletProceduralVolume(vec3i(128), vec3f(0.f), vec3f(1.f)));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vklSetString(vklVolume, "filter", filters[state.range(0)]);
+  vklCommit(vklVolume);
+
+  state.SetLabel(filters[state.range(0)]);
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  int valid[W];
+
+  for (int i = 0; i < W; i++) {
+    valid[i] = 1;
+  }
+
+  struct vvec3f
+  {
+    float x[W];
+    float y[W];
+    float z[W];
+  };
+
+  vvec3f objectCoordinates;
+  float samples[W];
+
+  for (auto _ : state) {
+    for (int i = 0; i < W; i++) {
+      objectCoordinates.x[i] = distX(eng);
+      objectCoordinates.y[i] = distY(eng);
+      objectCoordinates.z[i] = distZ(eng);
+    }
+
+    if (W == 4) {
+      vklComputeSample4(
+          valid, vklVolume, (const vkl_vvec3f4 *)&objectCoordinates, samples);
+    } else if (W == 8) {
+      vklComputeSample8(
+          valid, vklVolume, (const vkl_vvec3f8 *)&objectCoordinates, samples);
+    } else if (W == 16) {
+      vklComputeSample16(
+          valid, vklVolume, (const vkl_vvec3f16 *)&objectCoordinates, samples);
+    } else {
+      throw std::runtime_error(
+          "vectorRandomSampleFilter benchmark called with unimplemented "
+          "calling width");
+    }
+  }
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations() * W);
+}
+
+BENCHMARK_TEMPLATE(vectorRandomSampleFilter, 4)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(vectorRandomSampleFilter, 8)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(vectorRandomSampleFilter, 16)->DenseRange(0, 2);
+
+// vector sampling of a volume larger than typical last-level caches, to compare
+// memory bandwidth bound sampling for different voxel types
+template <typename VOLUME_TYPE, int W>
+void vectorRandomSampleVoxelType(benchmark::State &state)
+{
+  std::unique_ptr<VOLUME_TYPE> v(
+      new VOLUME_TYPE(vec3i(256), vec3f(0.f), vec3f(1.f)));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  int valid[W];
+
+  for (int i = 0; i < W; i++) {
+    valid[i] = 1;
+  }
+
+  struct vvec3f
+  {
+    float x[W];
+    float y[W];
+    float z[W];
+  };
+
+  vvec3f objectCoordinates;
+  float samples[W];
+
+  for (auto _ : state) {
+    for (int i = 0; i < W; i++) {
+      objectCoordinates.x[i] = distX(eng);
+      objectCoordinates.y[i] = distY(eng);
+      objectCoordinates.z[i] = distZ(eng);
+    }
+
+    if (W == 4) {
+      vklComputeSample4(
+          valid, vklVolume, (const vkl_vvec3f4 *)&objectCoordinates, samples);
+    } else if (W == 8) {
+      vklComputeSample8(
+          valid, vklVolume, (const vkl_vvec3f8 *)&objectCoordinates, samples);
+    } else if (W == 16) {
+      vklComputeSample16(
+          valid, vklVolume, (const vkl_vvec3f16 *)&objectCoordinates, samples);
+    } else {
+      throw std::runtime_error(
+          "vectorRandomSampleVoxelType benchmark called with unimplemented "
+          "calling width");
+    }
+  }
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations() * W);
+}
+
+BENCHMARK_TEMPLATE(vectorRandomSampleVoxelType,
+                   WaveletProceduralVolumeFloat,
+                   8);
+BENCHMARK_TEMPLATE(vectorRandomSampleVoxelType,
+                   WaveletProceduralVolumeHalf,
+                   8);
+BENCHMARK_TEMPLATE(vectorRandomSampleVoxelType,
+                   WaveletProceduralVolumeBfloat16,
+                   8);
+BENCHMARK_TEMPLATE(vectorRandomSampleVoxelType,
+                   WaveletProceduralVolumeFloat,
+                   16);
+BENCHMARK_TEMPLATE(vectorRandomSampleVoxelType,
+                   WaveletProceduralVolumeHalf,
+                   16);
+BENCHMARK_TEMPLATE(vectorRandomSampleVoxelType,
+                   WaveletProceduralVolumeBfloat16,
+                   16);
+
+// vector sampling of three attributes on the same grid; state.range(0) selects
+// between three separate volumes (0) and one multi-attribute volume sampled
+// with vklComputeSampleM (1)
+template <int W>
+void vectorRandomSampleMultiAttribute(benchmark::State &state)
+{
+  const unsigned int numAttributes = 3;
+
+  std::unique_ptr<WaveletProceduralVolume> v(
+      new WaveletProceduralVolume(vec3i(128), vec3f(0.f), vec3f(1.f)));
+
+  std::vector<unsigned char> voxels = v->generateVoxels();
+
+  VKLVolume separateVolumes[numAttributes];
+  std::vector<VKLData> attributes;
+
+  for (unsigned int a = 0; a < numAttributes; a++) {
+    attributes.push_back(vklNewData(
+        longProduct(v->getDimensions()), VKL_FLOAT, voxels.data()));
+
+    separateVolumes[a] = vklNewVolume("structured_regular");
+    vklSetVec3i(separateVolumes[a], "dimensions", 128, 128, 128);
+    vklSetData(separateVolumes[a], "voxelData", attributes.back());
+    vklCommit(separateVolumes[a]);
+  }
+
+  VKLVolume multiVolume = vklNewVolume("structured_regular");
+  vklSetVec3i(multiVolume, "dimensions", 128, 128, 128);
+
+  VKLData voxelData =
+      vklNewData(attributes.size(), VKL_DATA, attributes.data());
+  vklSetData(multiVolume, "voxelData", voxelData);
+  vklRelease(voxelData);
+
+  vklCommit(multiVolume);
+
+  for (auto &a : attributes)
+    vklRelease(a);
+
+  const bool useSampleM = state.range(0);
+
+  const unsigned int attributeIndices[numAttributes] = {0, 1, 2};
+
+  vkl_box3f bbox = vklGetBoundingBox(multiVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  int valid[W];
+
+  for (int i = 0; i < W; i++) {
+    valid[i] = 1;
+  }
+
+  struct vvec3f
+  {
+    float x[W];
+    float y[W];
+    float z[W];
+  };
+
+  vvec3f objectCoordinates;
+  float samples[numAttributes * W];
+
+  for (auto _ : state) {
+    for (int i = 0; i < W; i++) {
+      objectCoordinates.x[i] = distX(eng);
+      objectCoordinates.y[i] = distY(eng);
+      objectCoordinates.z[i] = distZ(eng);
+    }
+
+    if (useSampleM) {
+      if (W == 4) {
+        vklComputeSampleM4(valid,
+                           multiVolume,
+                           (const vkl_vvec3f4 *)&objectCoordinates,
+                           samples,
+                           numAttributes,
+                           attributeIndices);
+      } else if (W == 8) {
+        vklComputeSampleM8(valid,
+                           multiVolume,
+                           (const vkl_vvec3f8 *)&objectCoordinates,
+                           samples,
+                           numAttributes,
+                           attributeIndices);
+      } else if (W == 16) {
+        vklComputeSampleM16(valid,
+                            multiVolume,
+                            (const vkl_vvec3f16 *)&objectCoordinates,
+                            samples,
+                            numAttributes,
+                            attributeIndices);
+      } else {
+        throw std::runtime_error(
+            "vectorRandomSampleMultiAttribute benchmark called with "
+            "unimplemented calling width");
+      }
+    } else {
+      for (unsigned int a = 0; a < numAttributes; a++) {
+        if (W == 4) {
+          vklComputeSample4(valid,
+                            separateVolumes[a],
+                            (const vkl_vvec3f4 *)&objectCoordinates,
+                            samples + a * W);
+        } else if (W == 8) {
+          vklComputeSample8(valid,
+                            separateVolumes[a],
+                            (const vkl_vvec3f8 *)&objectCoordinates,
+                            samples + a * W);
+        } else if (W == 16) {
+          vklComputeSample16(valid,
+                             separateVolumes[a],
+                             (const vkl_vvec3f16 *)&objectCoordinates,
+                             samples + a * W);
+        } else {
+          throw std::runtime_error(
+              "vectorRandomSampleMultiAttribute benchmark called with "
+              "unimplemented calling width");
+        }
+      }
+    }
+  }
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations() * W);
+
+  for (unsigned int a = 0; a < numAttributes; a++)
+    vklRelease(separateVolumes[a]);
+
+  vklRelease(multiVolume);
+}
+
+BENCHMARK_TEMPLATE(vectorRandomSampleMultiAttribute, 4)->DenseRange(0, 1);
+BENCHMARK_TEMPLATE(vectorRandomSampleMultiAttribute, 8)->DenseRange(0, 1);
+BENCHMARK_TEMPLATE(vectorRandomSampleMultiAttribute, 16)->DenseRange(0, 1);
+
+// vector sampling with only one active lane; compare against
+// scalarRandomSample, which uses dedicated scalar code paths
+template <int W>
+void vectorSingleLaneRandomSample(benchmark::State &state)
+{
+  std::unique_ptr<WaveletProceduralVolume> v(
+      new WaveletProceduralVolume(vec3i(128), vec3f(0.f), vec3f(1.f)));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  int valid[W];
+
+  for (int i = 0; i < W; i++) {
+    valid[i] = i == 0;
+  }
+
+  struct vvec3f
+  {
+    float x[W];
+    float y[W];
+    float z[W];
+  };
+
+  vvec3f objectCoordinates;
+  float samples[W];
+
+  for (int i = 0; i < W; i++) {
+    objectCoordinates.x[i] = 0.f;
+    objectCoordinates.y[i] = 0.f;
+    objectCoordinates.z[i] = 0.f;
+  }
+
+  for (auto _ : state) {
+    objectCoordinates.x[0] = distX(eng);
+    objectCoordinates.y[0] = distY(eng);
+    objectCoordinates.z[0] = distZ(eng);
+
+    if (W == 4) {
+      vklComputeSample4(
+          valid, vklVolume, (const vkl_vvec3f4 *)&objectCoordinates, samples);
+    } else if (W == 8) {
+      vklComputeSample8(
+          valid, vklVolume, (const vkl_vvec3f8 *)&objectCoordinates, samples);
+    } else if (W == 16) {
+      vklComputeSample16(
+          valid, vklVolume, (const vkl_vvec3f16 *)&objectCoordinates, samples);
+    } else {
+      throw std::runtime_error(
+          "vectorSingleLaneRandomSample benchmark called with unimplemented "
+          "calling width");
+    }
+
+    benchmark::DoNotOptimize(samples[0]);
+  }
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(vectorSingleLaneRandomSample, 4);
+BENCHMARK_TEMPLATE(vectorSingleLaneRandomSample, 8);
+BENCHMARK_TEMPLATE(vectorSingleLaneRandomSample, 16);
+
+static void streamRandomSample(benchmark::State &state)
+{
+  std::unique_ptr<WaveletProceduralVolume> v(
+      new WaveletProceduralVolume(vec3i(128), vec3f(0.f), vec3f(1.f)));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  const size_t count = state.range(0);
+
+  // generate coordinates once up front; this benchmark measures throughput of
+  // the stream API rather than random number generation
+  std::vector<vkl_vec3f> objectCoordinates(count);
+  std::vector<float> samples(count);
+
+  for (auto &oc : objectCoordinates) {
+    oc = vkl_vec3f{distX(eng), distY(eng), distZ(eng)};
+  }
+
+  for (auto _ : state) {
+    vklComputeSampleStream(
+        vklVolume, count, objectCoordinates.data(), samples.data());
+
+    benchmark::DoNotOptimize(samples.data());
+  }
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(streamRandomSample)->Range(1 << 10, 1 << 20)->UseRealTime();
+
 static void scalarFixedSample(benchmark::State &state)
 {
   std::unique_ptr<WaveletProceduralVolume> v(
@@ -573,6 +981,97 @@ BENCHMARK(scalarIntervalIteratorIterateSecond)->Threads(12)->UseRealTime();
 BENCHMARK(scalarIntervalIteratorIterateSecond)->Threads(36)->UseRealTime();
 BENCHMARK(scalarIntervalIteratorIterateSecond)->Threads(72)->UseRealTime();
 
+// accelerator build time on commit, for macrocell sizes given by
+// state.range(0)
+static void acceleratorBuildMacrocellSize(benchmark::State &state)
+{
+  std::unique_ptr<WaveletProceduralVolume> v(
+      new WaveletProceduralVolume(vec3i(256), vec3f(0.f), vec3f(1.f)));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  const int macrocellSize = state.range(0);
+
+  state.SetLabel("macrocellSize " + std::to_string(macrocellSize));
+
+  for (auto _ : state) {
+    vklSetInt(vklVolume, "macrocellSize", macrocellSize);
+    vklCommit(vklVolume);
+  }
+}
+
+BENCHMARK(acceleratorBuildMacrocellSize)
+    ->RangeMultiplier(2)
+    ->Range(4, 64)
+    ->Unit(benchmark::kMillisecond);
+
+// full interval iteration along random rays, for macrocell sizes given by
+// state.range(0); the value selector selects a thin slab of the volume, so most
+// macrocells along each ray are skipped
+static void scalarIntervalIteratorIterateAllMacrocellSize(
+    benchmark::State &state)
+{
+  std::unique_ptr<ZProceduralVolume> v(
+      new ZProceduralVolume(vec3i(256), vec3f(0.f), vec3f(1.f)));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  const int macrocellSize = state.range(0);
+
+  vklSetInt(vklVolume, "macrocellSize", macrocellSize);
+  vklCommit(vklVolume);
+
+  state.SetLabel("macrocellSize " + std::to_string(macrocellSize));
+
+  VKLValueSelector valueSelector = vklNewValueSelector(vklVolume);
+
+  vkl_range1f valueRange{120.f, 136.f};
+  vklValueSelectorSetRanges(valueSelector, 1, &valueRange);
+  vklCommit(valueSelector);
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+  std::uniform_real_distribution<float> distDirection(-1.f, 1.f);
+
+  size_t numIntervals = 0;
+
+  for (auto _ : state) {
+    vkl_vec3f origin{distX(eng), distY(eng), distZ(eng)};
+    vkl_vec3f direction{distDirection(eng), distDirection(eng), 1.f};
+    vkl_range1f tRange{0.f, inf};
+
+    VKLIntervalIterator iterator;
+    vklInitIntervalIterator(
+        &iterator, vklVolume, &origin, &direction, &tRange, valueSelector);
+
+    VKLInterval interval;
+
+    while (vklIterateInterval(&iterator, &interval)) {
+      numIntervals++;
+    }
+
+    benchmark::DoNotOptimize(interval);
+  }
+
+  state.counters["intervals"] = benchmark::Counter(
+      numIntervals, benchmark::Counter::kAvgIterations);
+
+  vklRelease(valueSelector);
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(scalarIntervalIteratorIterateAllMacrocellSize)
+    ->RangeMultiplier(2)
+    ->Range(4, 64);
+
 // based on BENCHMARK_MAIN() macro from benchmark.h
 int main(int argc, char **argv)
 {
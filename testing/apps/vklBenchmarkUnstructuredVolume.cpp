@@ -150,6 +150,80 @@ BENCHMARK_ALL_PRIMS(vectorRandomSample, 4)
 BENCHMARK_ALL_PRIMS(vectorRandomSample, 8)
 BENCHMARK_ALL_PRIMS(vectorRandomSample, 16)
 
+// random vectorized sampling with each BVH traversal method: packet, per-lane
+// and automatic (range 0)
+template <int W>
+void vectorRandomSampleBVHTraversal(benchmark::State &state)
+{
+  const char *bvhTraversals[] = {"packet", "lane", "auto"};
+
+  std::unique_ptr<WaveletUnstructuredProceduralVolume> v(
+      new WaveletUnstructuredProceduralVolume(
+          vec3i(128), vec3f(0.f), vec3f(1.f), VKL_HEXAHEDRON));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vklSetString(vklVolume, "bvhTraversal", bvhTraversals[state.range(0)]);
+  vklCommit(vklVolume);
+
+  state.SetLabel(bvhTraversals[state.range(0)]);
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+
+  int valid[W];
+
+  for (int i = 0; i < W; i++) {
+    valid[i] = 1;
+  }
+
+  struct vvec3f
+  {
+    float x[W];
+    float y[W];
+    float z[W];
+  };
+
+  vvec3f objectCoordinates;
+  float samples[W];
+
+  for (auto _ : state) {
+    for (int i = 0; i < W; i++) {
+      objectCoordinates.x[i] = distX(eng);
+      objectCoordinates.y[i] = distY(eng);
+      objectCoordinates.z[i] = distZ(eng);
+    }
+
+    if (W == 4) {
+      vklComputeSample4(
+          valid, vklVolume, (const vkl_vvec3f4 *)&objectCoordinates, samples);
+    } else if (W == 8) {
+      vklComputeSample8(
+          valid, vklVolume, (const vkl_vvec3f8 *)&objectCoordinates, samples);
+    } else if (W == 16) {
+      vklComputeSample16(
+          valid, vklVolume, (const vkl_vvec3f16 *)&objectCoordinates, samples);
+    } else {
+      throw std::runtime_error(
+          "vectorRandomSampleBVHTraversal benchmark called with unimplemented "
+          "calling width");
+    }
+  }
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations() * W);
+}
+
+BENCHMARK_TEMPLATE(vectorRandomSampleBVHTraversal, 4)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(vectorRandomSampleBVHTraversal, 8)->DenseRange(0, 2);
+BENCHMARK_TEMPLATE(vectorRandomSampleBVHTraversal, 16)->DenseRange(0, 2);
+
 template <VKLUnstructuredCellType primType>
 static void scalarFixedSample(benchmark::State &state)
 {
@@ -248,6 +322,155 @@ BENCHMARK_ALL_PRIMS(vectorFixedSample, 4)
 BENCHMARK_ALL_PRIMS(vectorFixedSample, 8)
 BENCHMARK_ALL_PRIMS(vectorFixedSample, 16)
 
+// BVH build time on commit; the BVH size and SAH cost of each build are
+// logged with VKL_LOG_LEVEL=debug
+template <VKLUnstructuredCellType primType>
+static void bvhBuild(benchmark::State &state)
+{
+  std::unique_ptr<WaveletUnstructuredProceduralVolume> v(
+      new WaveletUnstructuredProceduralVolume(
+          vec3i(128), vec3f(0.f), vec3f(1.f), primType));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  for (auto _ : state) {
+    vklCommit(vklVolume);
+  }
+}
+
+BENCHMARK_TEMPLATE(bvhBuild, VKL_HEXAHEDRON)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bvhBuild, VKL_TETRAHEDRON)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bvhBuild, VKL_WEDGE)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bvhBuild, VKL_PYRAMID)->Unit(benchmark::kMillisecond);
+
+// full interval iteration along random rays, which traverses the BVH and so
+// reflects its quality; the value selector selects part of the value range, so
+// that some nodes along each ray are skipped
+template <VKLUnstructuredCellType primType>
+static void scalarIntervalIteratorIterateAll(benchmark::State &state)
+{
+  std::unique_ptr<WaveletUnstructuredProceduralVolume> v(
+      new WaveletUnstructuredProceduralVolume(
+          vec3i(128), vec3f(0.f), vec3f(1.f), primType));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  VKLValueSelector valueSelector = vklNewValueSelector(vklVolume);
+
+  vkl_range1f valueRange{0.5f, 1.f};
+  vklValueSelectorSetRanges(valueSelector, 1, &valueRange);
+  vklCommit(valueSelector);
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+  std::uniform_real_distribution<float> distDirection(-1.f, 1.f);
+
+  size_t numIntervals = 0;
+
+  for (auto _ : state) {
+    vkl_vec3f origin{distX(eng), distY(eng), distZ(eng)};
+    vkl_vec3f direction{distDirection(eng), distDirection(eng), 1.f};
+    vkl_range1f tRange{0.f, inf};
+
+    VKLIntervalIterator iterator;
+    vklInitIntervalIterator(
+        &iterator, vklVolume, &origin, &direction, &tRange, valueSelector);
+
+    VKLInterval interval;
+
+    while (vklIterateInterval(&iterator, &interval)) {
+      numIntervals++;
+    }
+
+    benchmark::DoNotOptimize(interval);
+  }
+
+  state.counters["intervals"] =
+      benchmark::Counter(numIntervals, benchmark::Counter::kAvgIterations);
+
+  vklRelease(valueSelector);
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(scalarIntervalIteratorIterateAll, VKL_HEXAHEDRON);
+BENCHMARK_TEMPLATE(scalarIntervalIteratorIterateAll, VKL_TETRAHEDRON);
+BENCHMARK_TEMPLATE(scalarIntervalIteratorIterateAll, VKL_WEDGE);
+BENCHMARK_TEMPLATE(scalarIntervalIteratorIterateAll, VKL_PYRAMID);
+
+// full hit iteration along random rays, without (range 0) and with (range 1)
+// precomputed neighbors, which let consecutive samples walk between cells
+template <VKLUnstructuredCellType primType>
+static void scalarHitIteratorIterateAll(benchmark::State &state)
+{
+  std::unique_ptr<WaveletUnstructuredProceduralVolume> v(
+      new WaveletUnstructuredProceduralVolume(
+          vec3i(128), vec3f(0.f), vec3f(1.f), primType));
+
+  VKLVolume vklVolume = v->getVKLVolume();
+
+  vklSetBool(vklVolume, "precomputedNeighbors", state.range(0));
+  vklCommit(vklVolume);
+
+  VKLValueSelector valueSelector = vklNewValueSelector(vklVolume);
+
+  std::vector<float> isoValues{-1.f, 0.f, 1.f};
+  vklValueSelectorSetValues(valueSelector, isoValues.size(), isoValues.data());
+  vklCommit(valueSelector);
+
+  vkl_box3f bbox = vklGetBoundingBox(vklVolume);
+
+  std::random_device rd;
+  std::mt19937 eng(rd());
+
+  std::uniform_real_distribution<float> distX(bbox.lower.x, bbox.upper.x);
+  std::uniform_real_distribution<float> distY(bbox.lower.y, bbox.upper.y);
+  std::uniform_real_distribution<float> distZ(bbox.lower.z, bbox.upper.z);
+  std::uniform_real_distribution<float> distDirection(-1.f, 1.f);
+
+  size_t numHits = 0;
+
+  for (auto _ : state) {
+    vkl_vec3f origin{distX(eng), distY(eng), distZ(eng)};
+    vkl_vec3f direction{distDirection(eng), distDirection(eng), 1.f};
+    vkl_range1f tRange{0.f, inf};
+
+    VKLHitIterator iterator;
+    vklInitHitIterator(
+        &iterator, vklVolume, &origin, &direction, &tRange, valueSelector);
+
+    VKLHit hit;
+
+    while (vklIterateHit(&iterator, &hit)) {
+      numHits++;
+    }
+
+    benchmark::DoNotOptimize(hit);
+  }
+
+  state.counters["hits"] =
+      benchmark::Counter(numHits, benchmark::Counter::kAvgIterations);
+
+  vklRelease(valueSelector);
+
+  // enables rates in report output
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(scalarHitIteratorIterateAll, VKL_HEXAHEDRON)
+    ->DenseRange(0, 1);
+BENCHMARK_TEMPLATE(scalarHitIteratorIterateAll, VKL_TETRAHEDRON)
+    ->DenseRange(0, 1);
+BENCHMARK_TEMPLATE(scalarHitIteratorIterateAll, VKL_WEDGE)->DenseRange(0, 1);
+BENCHMARK_TEMPLATE(scalarHitIteratorIterateAll, VKL_PYRAMID)->DenseRange(0, 1);
+
 // based on BENCHMARK_MAIN() macro from benchmark.h
 int main(int argc, char **argv)
 {
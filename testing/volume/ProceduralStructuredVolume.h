@@ -37,9 +37,11 @@ namespace openvkl {
               vec3f gradientFunction(const vec3f &) = gradientNotImplemented>
     struct ProceduralStructuredVolume : public TestingStructuredVolume
     {
-      ProceduralStructuredVolume(const vec3i &dimensions,
-                                 const vec3f &gridOrigin,
-                                 const vec3f &gridSpacing);
+      ProceduralStructuredVolume(
+          const vec3i &dimensions,
+          const vec3f &gridOrigin,
+          const vec3f &gridSpacing,
+          const std::string &gridType = "structured_regular");
 
       VOXEL_TYPE computeProceduralValue(const vec3f &objectCoordinates);
 
@@ -53,13 +55,14 @@ namespace openvkl {
     template <typename VOXEL_TYPE,
               VOXEL_TYPE samplingFunction(const vec3f &),
               vec3f gradientFunction(const vec3f &)>
-    inline ProceduralStructuredVolume<
-        VOXEL_TYPE,
-        samplingFunction,
-        gradientFunction>::ProceduralStructuredVolume(const vec3i &dimensions,
-                                                      const vec3f &gridOrigin,
-                                                      const vec3f &gridSpacing)
-        : TestingStructuredVolume("structured_regular",
+    inline ProceduralStructuredVolume<VOXEL_TYPE,
+                                      samplingFunction,
+                                      gradientFunction>::
+        ProceduralStructuredVolume(const vec3i &dimensions,
+                                   const vec3f &gridOrigin,
+                                   const vec3f &gridSpacing,
+                                   const std::string &gridType)
+        : TestingStructuredVolume(gridType,
                                   dimensions,
                                   gridOrigin,
                                   gridSpacing,
@@ -142,6 +145,12 @@ namespace openvkl {
     using WaveletProceduralVolumeDouble =
         ProceduralStructuredVolume<double, getWaveletValue<double>>;
 
+    using WaveletProceduralVolumeHalf =
+        ProceduralStructuredVolume<half_float, getWaveletValue<half_float>>;
+
+    using WaveletProceduralVolumeBfloat16 =
+        ProceduralStructuredVolume<bfloat16, getWaveletValue<bfloat16>>;
+
     using WaveletProceduralVolume = WaveletProceduralVolumeFloat;
 
     using ZProceduralVolume =
@@ -36,6 +36,7 @@ namespace openvkl {
       vec3i getDimensions() const;
       vec3f getGridOrigin() const;
       vec3f getGridSpacing() const;
+      VKLDataType getVoxelType() const;
 
       // allow external access to underlying voxel data (e.g. for conversion to
       // other volume formats / types)
@@ -82,6 +83,11 @@ namespace openvkl {
       return gridSpacing;
     }
 
+    inline VKLDataType TestingStructuredVolume::getVoxelType() const
+    {
+      return voxelType;
+    }
+
     inline void TestingStructuredVolume::generateVKLVolume()
     {
       std::vector<unsigned char> voxels = generateVoxels();
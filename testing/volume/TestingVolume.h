@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "float16_types.h"
 // openvkl
 #include "openvkl/openvkl.h"
 // ospcommon
@@ -48,6 +49,10 @@ namespace openvkl {
         return VKL_FLOAT;
       } else if (std::is_same<T, double>::value) {
         return VKL_DOUBLE;
+      } else if (std::is_same<T, half_float>::value) {
+        return VKL_HALF;
+      } else if (std::is_same<T, bfloat16>::value) {
+        return VKL_BFLOAT16;
       } else {
         return VKL_UNKNOWN;
       }
@@ -66,6 +71,10 @@ namespace openvkl {
         return sizeof(float);
       case VKL_DOUBLE:
         return sizeof(double);
+      case VKL_HALF:
+        return sizeof(half_float);
+      case VKL_BFLOAT16:
+        return sizeof(bfloat16);
       case VKL_UNKNOWN:
         break;
       default:
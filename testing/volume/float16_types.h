@@ -0,0 +1,202 @@
+// ======================================================================== //
+// Copyright 2019 Intel Corporation                                         //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace openvkl {
+  namespace testing {
+
+    // host-side 16-bit floating point types matching VKL_HALF and
+    // VKL_BFLOAT16 voxel data; values are converted with round-to-nearest-even
+
+    struct half_float
+    {
+      uint16_t bits;
+
+      half_float() = default;
+
+      half_float(float value) : bits(floatToBits(value)) {}
+
+      operator float() const
+      {
+        return bitsToFloat(bits);
+      }
+
+      static uint16_t floatToBits(float value);
+      static float bitsToFloat(uint16_t bits);
+    };
+
+    struct bfloat16
+    {
+      uint16_t bits;
+
+      bfloat16() = default;
+
+      bfloat16(float value) : bits(floatToBits(value)) {}
+
+      operator float() const
+      {
+        return bitsToFloat(bits);
+      }
+
+      static uint16_t floatToBits(float value);
+      static float bitsToFloat(uint16_t bits);
+    };
+
+    // Inlined definitions ////////////////////////////////////////////////////
+
+    inline uint16_t half_float::floatToBits(float value)
+    {
+      uint32_t x;
+      std::memcpy(&x, &value, sizeof(x));
+
+      const uint32_t sign       = (x >> 16) & 0x8000;
+      const uint32_t exponent32 = (x >> 23) & 0xff;
+      const int32_t exponent    = int32_t(exponent32) - 127 + 15;
+      uint32_t mantissa         = x & 0x7fffff;
+
+      // infinity and NaN
+      if (exponent32 == 0xff)
+        return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+
+      // overflow to infinity
+      if (exponent >= 31)
+        return sign | 0x7c00;
+
+      // subnormal results, or underflow to zero
+      if (exponent <= 0) {
+        if (exponent < -10)
+          return sign;
+
+        mantissa |= 0x800000;
+
+        const uint32_t shift     = 14 - exponent;
+        uint32_t half            = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway   = 1u << (shift - 1);
+
+        if (remainder > halfway || (remainder == halfway && (half & 1)))
+          half++;
+
+        return sign | half;
+      }
+
+      uint32_t half            = (uint32_t(exponent) << 10) | (mantissa >> 13);
+      const uint32_t remainder = mantissa & 0x1fff;
+
+      // a carry out of the mantissa correctly increments the exponent
+      if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+        half++;
+
+      return sign | half;
+    }
+
+    inline float half_float::bitsToFloat(uint16_t bits)
+    {
+      const uint32_t sign     = uint32_t(bits & 0x8000) << 16;
+      const uint32_t exponent = (bits >> 10) & 0x1f;
+      uint32_t mantissa       = bits & 0x3ff;
+
+      uint32_t x;
+
+      if (exponent == 0x1f) {
+        x = sign | 0x7f800000 | (mantissa << 13);
+      } else if (exponent != 0) {
+        x = sign | ((exponent + 112) << 23) | (mantissa << 13);
+      } else if (mantissa == 0) {
+        x = sign;
+      } else {
+        // normalize subnormal values
+        uint32_t e = 113;
+        while (!(mantissa & 0x400)) {
+          mantissa <<= 1;
+          e--;
+        }
+        x = sign | (e << 23) | ((mantissa & 0x3ff) << 13);
+      }
+
+      float value;
+      std::memcpy(&value, &x, sizeof(value));
+      return value;
+    }
+
+    inline uint16_t bfloat16::floatToBits(float value)
+    {
+      uint32_t x;
+      std::memcpy(&x, &value, sizeof(x));
+
+      // keep NaNs quiet rather than rounding them to infinity
+      if ((x & 0x7fffffff) > 0x7f800000)
+        return (x >> 16) | 0x40;
+
+      x += 0x7fff + ((x >> 16) & 1);
+      return x >> 16;
+    }
+
+    inline float bfloat16::bitsToFloat(uint16_t bits)
+    {
+      const uint32_t x = uint32_t(bits) << 16;
+
+      float value;
+      std::memcpy(&value, &x, sizeof(value));
+      return value;
+    }
+
+  }  // namespace testing
+}  // namespace openvkl
+
+namespace std {
+
+  template <>
+  class numeric_limits<openvkl::testing::half_float>
+  {
+   public:
+    static constexpr bool is_specialized = true;
+
+    static openvkl::testing::half_float lowest()
+    {
+      return -65504.f;
+    }
+
+    static openvkl::testing::half_float max()
+    {
+      return 65504.f;
+    }
+  };
+
+  template <>
+  class numeric_limits<openvkl::testing::bfloat16>
+  {
+   public:
+    static constexpr bool is_specialized = true;
+
+    // largest finite bfloat16 values
+    static openvkl::testing::bfloat16 lowest()
+    {
+      return openvkl::testing::bfloat16::bitsToFloat(0xff7f);
+    }
+
+    static openvkl::testing::bfloat16 max()
+    {
+      return openvkl::testing::bfloat16::bitsToFloat(0x7f7f);
+    }
+  };
+
+}  // namespace std